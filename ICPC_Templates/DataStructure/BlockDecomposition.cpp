@@ -2,6 +2,8 @@
  * 分块 (Block Decomposition)
  * 功能：区间查询与修改
  * 复杂度：O(√n)
+ * BlockDecompositionT<Info, Tag, B> 为通用版本，Info/Tag 约定与 SegmentTree.cpp 相同
+ * （Info() 需为单位元）；块大小可在编译期给定，或用 tune() 在启动时实测选取
  */
 #include <bits/stdc++.h>
 using namespace std;
@@ -83,3 +85,201 @@ struct BlockDecomposition {
         return res;
     }
 };
+
+// 按 64 字节对齐分配，配合块大小为 LINE 的整数倍，使每块从缓存行开头开始
+template <class T>
+struct AlignedAllocator {
+    using value_type = T;
+
+    AlignedAllocator() = default;
+    template <class U>
+    AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), align_val_t(64)));
+    }
+    void deallocate(T* p, size_t) { ::operator delete(p, align_val_t(64)); }
+
+    template <class U>
+    bool operator==(const AlignedAllocator<U>&) const {
+        return true;
+    }
+    template <class U>
+    bool operator!=(const AlignedAllocator<U>&) const {
+        return false;
+    }
+};
+
+template <class Info, class Tag, int B = 0>
+struct BlockDecompositionT {
+    // 每块的字节数需为 lcm(sizeof(Info), 64) 的整数倍，块首才落在缓存行开头
+    static constexpr int LINE = lcm<size_t>(sizeof(Info), 64) / sizeof(Info);
+    int n, bs, bn;
+    vector<Info, AlignedAllocator<Info>> a;  // 元素，不含所在块的懒标记
+    vector<Info> sum;                         // 块内元素之和，已含懒标记
+    vector<Tag> tag;
+
+    BlockDecompositionT() : n(0) {}
+    BlockDecompositionT(const vector<Info>& init_, int bs_ = B) {
+        init(init_, bs_);
+    }
+
+    // bs_ 为 0 时取 √n，并向上取整到 LINE 的整数倍
+    void init(const vector<Info>& init_, int bs_ = B) {
+        n = init_.size();
+        bs = bs_ > 0 ? bs_ : (int)sqrt(max(n, 1)) + 1;
+        bs = (bs + LINE - 1) / LINE * LINE;
+        bn = (n + bs - 1) / bs;
+        a.assign(init_.begin(), init_.end());
+        sum.assign(bn, Info());
+        tag.assign(bn, Tag());
+        for (int b = 0; b < bn; b++) {
+            rebuild(b);
+        }
+    }
+
+    void rebuild(int b) {
+        Info s;
+        for (int i = b * bs, e = min(n, i + bs); i < e; i++) {
+            s = s + a[i];
+        }
+        sum[b] = s;
+    }
+
+    void push(int b) {
+        for (int i = b * bs, e = min(n, i + bs); i < e; i++) {
+            a[i].apply(tag[b]);
+        }
+        tag[b] = Tag();
+    }
+
+    // 块内部分修改：先下放块标记，再逐个修改并重算块和；循环连续无分支，便于向量化
+    void partialApply(int b, int l, int r, const Tag& v) {
+        push(b);
+        for (int i = l; i < r; i++) {
+            a[i].apply(v);
+        }
+        rebuild(b);
+    }
+
+    void rangeApply(int l, int r, const Tag& v) {  // [l, r)
+        if (l >= r) {
+            return;
+        }
+        int bl = l / bs, br = (r - 1) / bs;
+        if (bl == br) {
+            partialApply(bl, l, r, v);
+            return;
+        }
+        partialApply(bl, l, (bl + 1) * bs, v);
+        for (int b = bl + 1; b < br; b++) {
+            sum[b].apply(v);
+            tag[b].apply(v);
+        }
+        partialApply(br, br * bs, r, v);
+    }
+
+    // 块内部分查询：先求原始元素之和，再整体作用块标记
+    Info partialQuery(int b, int l, int r) const {
+        Info s;
+        for (int i = l; i < r; i++) {
+            s = s + a[i];
+        }
+        s.apply(tag[b]);
+        return s;
+    }
+
+    Info rangeQuery(int l, int r) const {  // [l, r)
+        if (l >= r) {
+            return Info();
+        }
+        int bl = l / bs, br = (r - 1) / bs;
+        if (bl == br) {
+            return partialQuery(bl, l, r);
+        }
+        Info s = partialQuery(bl, l, (bl + 1) * bs);
+        for (int b = bl + 1; b < br; b++) {
+            s = s + sum[b];
+        }
+        return s + partialQuery(br, br * bs, r);
+    }
+
+    // 在真实数据上实测 √n/8 到 8√n 之间的若干块大小，返回随机区间操作最快的一个；
+    // 每个候选重复 reps 轮取中位数，减小单次计时的噪声
+    static int tune(const vector<Info>& init_, const Tag& v, int q = 4000,
+                    int reps = 5) {
+        int n = init_.size();
+        mt19937 rng(20251017);
+        vector<pair<int, int>> qs(q);
+        for (auto& [l, r] : qs) {
+            l = rng() % max(n, 1);
+            r = rng() % max(n, 1);
+            if (l > r) {
+                swap(l, r);
+            }
+            r++;
+        }
+        int best = 0;
+        double bestTime = 1e18;
+        int rt = sqrt(max(n, 1));
+        for (int cand = max(LINE, rt / 8); cand <= max(LINE, 8 * rt);
+             cand *= 2) {
+            BlockDecompositionT t(init_, cand);
+            vector<double> ts(reps);
+            for (auto& cur : ts) {
+                auto st = chrono::steady_clock::now();
+                for (int i = 0; i < q; i++) {
+                    auto [l, r] = qs[i];
+                    if (i & 1) {
+                        t.rangeApply(l, r, v);
+                    } else {
+                        volatile auto res = t.rangeQuery(l, r);
+                        (void)res;
+                    }
+                }
+                cur = chrono::duration<double>(chrono::steady_clock::now() - st)
+                          .count();
+            }
+            nth_element(ts.begin(), ts.begin() + reps / 2, ts.end());
+            double cur = ts[reps / 2];
+            if (cur < bestTime) {
+                bestTime = cur;
+                best = cand;
+            }
+        }
+        return best;
+    }
+};
+
+// 示例：区间加，区间求和（Info() 的 len 为 0，作为单位元）
+struct Tag {
+    ll add = 0;
+
+    void apply(const Tag& t) { add += t.add; }
+};
+
+struct Info {
+    ll sum = 0;
+    ll len = 0;
+
+    void apply(const Tag& t) { sum += t.add * len; }
+};
+
+Info operator+(const Info& a, const Info& b) {
+    return {a.sum + b.sum, a.len + b.len};
+}
+
+void example() {
+    vector<Info> init(10);
+    for (int i = 0; i < 10; i++) {
+        init[i] = {i, 1};
+    }
+
+    int bs = BlockDecompositionT<Info, Tag>::tune(init, Tag{1});
+    BlockDecompositionT<Info, Tag> blk(init, bs);
+    blk.rangeApply(2, 7, Tag{10});
+    cout << blk.rangeQuery(0, 10).sum << "\n";  // 45 + 50 = 95
+
+    BlockDecompositionT<Info, Tag, 64> fixed(init);  // 编译期块大小
+    cout << fixed.rangeQuery(3, 5).sum << "\n";     // 7
+}
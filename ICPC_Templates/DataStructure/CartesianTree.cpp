@@ -2,66 +2,207 @@
  * 笛卡尔树 (Cartesian Tree)
  * 功能：RMQ、最大矩形面积等
  * 复杂度：O(n) 构建
+ * cartesianTree 为单线程版本（预分配数组代替 std::stack），
+ * parallelCartesianTree 为多线程版本：分块求最近较小值（ANSV），再跨块合并
  */
 #include <bits/stdc++.h>
 using namespace std;
 
+// 小根堆性质，值相同时靠左的为祖先；没有对应节点时为 -1
+struct CartesianTree {
+    int root = -1;
+    vector<int> parent, left, right;
+};
+
+template <typename T>
+CartesianTree cartesianTree(const vector<T>& a) {
+    int n = a.size();
+    CartesianTree t;
+    t.parent.assign(n, -1);
+    t.left.assign(n, -1);
+    t.right.assign(n, -1);
+    vector<int> stk(n);
+    int top = 0;
+
+    for (int i = 0; i < n; i++) {
+        int last = -1;
+        while (top && a[stk[top - 1]] > a[i]) {
+            last = stk[--top];
+        }
+        if (top) {
+            t.right[stk[top - 1]] = i;
+            t.parent[i] = stk[top - 1];
+        }
+        if (last != -1) {
+            t.left[i] = last;
+            t.parent[last] = i;
+        }
+        stk[top++] = i;
+    }
+    t.root = n ? stk[0] : -1;
+    return t;
+}
+
 // 构建笛卡尔树（按小根堆性质）
 vector<int> buildCartesianTree(const vector<int>& a) {
+    return cartesianTree(a).parent;
+}
+
+// 多线程构建，结果与 cartesianTree 完全相同
+// 1. 每块内用单调栈求 L[i]（左侧最近的 a[j] <= a[i]）与 R[i]（右侧最近的 a[j] < a[i]），
+//    块内找不到的只可能是块的前缀最小值链 P 和后缀最小值链 S
+// 2. P 中元素的 L 落在左边第一个块最小值 <= a[i] 的块的 S 上，二分即可；R 同理
+// 3. parent 取 L、R 中值较大者（相等取 R），再由 parent 填 left/right
+template <typename T>
+CartesianTree parallelCartesianTree(const vector<T>& a, int threads = 0) {
     int n = a.size();
-    vector<int> parent(n, -1);
-    vector<int> left(n, -1);
-    vector<int> right(n, -1);
+    if (threads <= 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    int k = max(1, min(threads, n / 4096));
+    vector<int> st(k + 1);
+    for (int c = 0; c <= k; c++) {
+        st[c] = 1LL * n * c / k;
+    }
 
-    stack<int> stk;
+    CartesianTree t;
+    t.parent.assign(n, -1);
+    t.left.resize(n);
+    t.right.resize(n);
+    vector<int>&L = t.left, &R = t.right;
+    // 块 c 占用 buf[st[c] + c, st[c + 1] + c + 1)：S 从前往后放，P 从后往前放
+    vector<int> buf(n + k);
+    vector<int> sLen(k), pLen(k), mnPos(k);
 
-    for (int i = 0; i < n; i++) {
-        int last = -1;
-        while (!stk.empty() && a[stk.top()] > a[i]) {
-            last = stk.top();
-            stk.pop();
+    auto parallel = [&](auto&& fn) {
+        vector<thread> ths;
+        for (int c = 0; c < k; c++) {
+            ths.emplace_back(fn, c);
         }
+        for (auto& th : ths) {
+            th.join();
+        }
+    };
 
-        if (!stk.empty()) {
-            right[stk.top()] = i;
-            parent[i] = stk.top();
+    parallel([&](int c) {
+        int s = st[c], e = st[c + 1];
+        int* S = buf.data() + s + c;
+        int* P = buf.data() + e + c + 1;
+        int top = 0, p = 0;
+        for (int i = s; i < e; i++) {
+            while (top && a[S[top - 1]] > a[i]) {
+                R[S[--top]] = i;
+            }
+            if (top) {
+                L[i] = S[top - 1];
+            } else {
+                L[i] = -1;
+                *--P = i;
+                p++;
+            }
+            S[top++] = i;
+        }
+        for (int i = 0; i < top; i++) {
+            R[S[i]] = -1;
         }
+        sLen[c] = top;
+        pLen[c] = p;
+        mnPos[c] = S[0];
+    });
 
-        if (last != -1) {
-            left[i] = last;
-            parent[last] = i;
+    // P 链在 buf 中倒序存放，P(c)[0] 为块内最靠右的前缀最小值
+    auto S = [&](int c) { return buf.data() + st[c] + c; };
+    auto P = [&](int c) { return buf.data() + st[c + 1] + c + 1 - pLen[c]; };
+
+    parallel([&](int c) {
+        // P(c) 从左到右值严格递减，目标块只会往左移动
+        int b = c - 1;
+        for (int i = pLen[c] - 1; i >= 0; i--) {
+            int x = P(c)[i];
+            while (b >= 0 && a[mnPos[b]] > a[x]) {
+                b--;
+            }
+            if (b < 0) {
+                break;
+            }
+            // S(b) 中值不降，找最靠右的 a[j] <= a[x]
+            int* s = S(b);
+            int j = partition_point(s, s + sLen[b],
+                                    [&](int y) { return a[y] <= a[x]; }) -
+                    s;
+            L[x] = s[j - 1];
+        }
+        // S(c) 从右到左值不增，目标块只会往右移动
+        b = c + 1;
+        for (int i = sLen[c] - 1; i >= 0; i--) {
+            int x = S(c)[i];
+            while (b < k && a[mnPos[b]] >= a[x]) {
+                b++;
+            }
+            if (b == k) {
+                break;
+            }
+            // P(b) 倒序存放，从后往前值严格递减，找最靠左的 a[j] < a[x]
+            int* p = P(b);
+            int j = partition_point(p, p + pLen[b],
+                                    [&](int y) { return a[y] < a[x]; }) -
+                    p;
+            R[x] = p[j - 1];
         }
+    });
 
-        stk.push(i);
-    }
+    parallel([&](int c) {
+        for (int i = st[c]; i < st[c + 1]; i++) {
+            int l = L[i], r = R[i];
+            t.parent[i] = l == -1 ? r : r == -1 ? l : a[l] > a[r] ? l : r;
+        }
+    });
 
-    return parent;
+    parallel([&](int c) {
+        fill(L.begin() + st[c], L.begin() + st[c + 1], -1);
+        fill(R.begin() + st[c], R.begin() + st[c + 1], -1);
+    });
+
+    // 每个节点至多一个左儿子、一个右儿子，写入互不冲突
+    parallel([&](int c) {
+        for (int i = st[c]; i < st[c + 1]; i++) {
+            int p = t.parent[i];
+            if (p == -1) {
+                t.root = i;
+            } else if (p > i) {
+                L[p] = i;
+            } else {
+                R[p] = i;
+            }
+        }
+    });
+    return t;
 }
 
 // 使用笛卡尔树求最大矩形面积
 long long maxRectangleArea(const vector<int>& heights) {
     int n = heights.size();
-    vector<int> left(n), right(n);
-    stack<int> stk;
+    vector<int> left(n), right(n), stk(n);
+    int top = 0;
 
     // 找每个位置左边第一个小于它的位置
     for (int i = 0; i < n; i++) {
-        while (!stk.empty() && heights[stk.top()] >= heights[i]) {
-            stk.pop();
+        while (top && heights[stk[top - 1]] >= heights[i]) {
+            top--;
         }
-        left[i] = stk.empty() ? -1 : stk.top();
-        stk.push(i);
+        left[i] = top ? stk[top - 1] : -1;
+        stk[top++] = i;
     }
 
-    while (!stk.empty()) stk.pop();
+    top = 0;
 
     // 找每个位置右边第一个小于它的位置
     for (int i = n - 1; i >= 0; i--) {
-        while (!stk.empty() && heights[stk.top()] >= heights[i]) {
-            stk.pop();
+        while (top && heights[stk[top - 1]] >= heights[i]) {
+            top--;
         }
-        right[i] = stk.empty() ? n : stk.top();
-        stk.push(i);
+        right[i] = top ? stk[top - 1] : n;
+        stk[top++] = i;
     }
 
     long long maxArea = 0;
@@ -72,3 +213,36 @@ long long maxRectangleArea(const vector<int>& heights) {
 
     return maxArea;
 }
+
+// 基准测试：不同线程数下的加速比
+void benchmark(int n = 100000000) {
+    mt19937 rng(20251017);
+    vector<int> a(n);
+    for (auto& x : a) {
+        x = rng();
+    }
+
+    auto timeit = [&](auto&& fn) {
+        auto st = chrono::steady_clock::now();
+        fn();
+        return chrono::duration<double>(chrono::steady_clock::now() - st)
+            .count();
+    };
+
+    CartesianTree base;
+    double t1 = timeit([&] { base = cartesianTree(a); });
+    cout << "sequential: " << t1 << "s\n";
+    int hw = max(1u, thread::hardware_concurrency());
+    for (int th = 1; th <= hw; th *= 2) {
+        CartesianTree cur;
+        double t2 = timeit([&] { cur = parallelCartesianTree(a, th); });
+        assert(cur.parent == base.parent && cur.root == base.root);
+        cout << setw(3) << th << " threads: " << t2
+             << "s, speedup = " << t1 / t2 << "\n";
+    }
+}
+
+int main() {
+    benchmark();
+    return 0;
+}
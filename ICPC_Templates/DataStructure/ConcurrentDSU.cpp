@@ -0,0 +1,162 @@
+/**
+ * 并发并查集 (Concurrent DSU)
+ * 功能：多线程同时 merge / same / find，无锁（CAS 修改父指针）
+ * 复杂度：按随机优先级连边，期望树高 O(log n)；find 为带 CAS 的路径减半
+ * 注意：size 在所有并发 merge 结束后精确，并发进行中只是近似值
+ * 编译：g++ -O2 -pthread
+ */
+#include <bits/stdc++.h>
+using namespace std;
+
+struct ConcurrentDSU {
+    int n;
+    vector<atomic<int>> f, siz;
+    vector<unsigned> prio;
+
+    ConcurrentDSU() : n(0) {}
+    ConcurrentDSU(int n_) { init(n_); }
+
+    void init(int n_) {
+        n = n_;
+        f = vector<atomic<int>>(n);
+        siz = vector<atomic<int>>(n);
+        prio.resize(n);
+        for (int i = 0; i < n; i++) {
+            f[i].store(i, memory_order_relaxed);
+            siz[i].store(1, memory_order_relaxed);
+            // 固定的伪随机优先级，父亲优先级总是更高，保证无环且树高期望 O(log n)
+            unsigned long long z = i + 0x9e3779b97f4a7c15ULL;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            prio[i] = z ^ (z >> 31);
+        }
+    }
+
+    bool less(int x, int y) const {
+        return prio[x] != prio[y] ? prio[x] < prio[y] : x < y;
+    }
+
+    // 路径减半：CAS 失败说明别的线程已改过，直接继续往上走即可
+    int find(int x) {
+        while (true) {
+            int p = f[x].load(memory_order_acquire);
+            if (p == x) {
+                return x;
+            }
+            int g = f[p].load(memory_order_acquire);
+            if (g != p) {
+                f[x].compare_exchange_weak(p, g, memory_order_release,
+                                           memory_order_relaxed);
+            }
+            x = g;
+        }
+    }
+
+    // 返回 false 时，存在某一时刻 x、y 不连通
+    bool same(int x, int y) {
+        while (true) {
+            x = find(x);
+            y = find(y);
+            if (x == y) {
+                return true;
+            }
+            if (f[x].load(memory_order_acquire) == x) {
+                return false;
+            }
+        }
+    }
+
+    bool merge(int x, int y) {
+        while (true) {
+            x = find(x);
+            y = find(y);
+            if (x == y) {
+                return false;
+            }
+            if (less(y, x)) {
+                swap(x, y);
+            }
+            int e = x;
+            if (f[x].compare_exchange_strong(e, y, memory_order_acq_rel)) {
+                flush(x);
+                return true;
+            }
+        }
+    }
+
+    // 把非根节点上积累的 siz 推到当前的根上
+    void flush(int x) {
+        while (f[x].load(memory_order_acquire) != x) {
+            int d = siz[x].exchange(0);
+            if (d == 0) {
+                return;
+            }
+            x = find(x);
+            siz[x].fetch_add(d);
+        }
+    }
+
+    int size(int x) { return siz[find(x)].load(memory_order_relaxed); }
+};
+
+// 基准测试：多线程边流求连通块，与单线程 DSU 对比
+#include "DSU.cpp"
+
+void benchmark(int n = 10000000, long long m = 40000000) {
+    vector<pair<int, int>> edges(m);
+    mt19937 rng(20251017);
+    for (auto& [u, v] : edges) {
+        u = rng() % n;
+        v = rng() % n;
+    }
+
+    auto timeit = [&](auto&& fn) {
+        auto st = chrono::steady_clock::now();
+        fn();
+        return chrono::duration<double>(chrono::steady_clock::now() - st)
+            .count();
+    };
+
+    DSU dsu(n);
+    int comp = n;
+    double base = timeit([&] {
+        for (auto [u, v] : edges) {
+            comp -= dsu.merge(u, v);
+        }
+    });
+    cout << "DSU             1 thread : " << base << "s, comp = " << comp
+         << "\n";
+
+    int hw = max(1u, thread::hardware_concurrency());
+    for (int t = 1; t <= hw; t *= 2) {
+        ConcurrentDSU cdsu(n);
+        atomic<int> merged = 0;
+        double cur = timeit([&] {
+            vector<thread> ths;
+            for (int id = 0; id < t; id++) {
+                ths.emplace_back([&, id] {
+                    int cnt = 0;
+                    for (long long i = id; i < m; i += t) {
+                        cnt += cdsu.merge(edges[i].first, edges[i].second);
+                    }
+                    merged += cnt;
+                });
+            }
+            for (auto& th : ths) {
+                th.join();
+            }
+        });
+        cout << "ConcurrentDSU " << setw(2) << t << " threads: " << cur
+             << "s, comp = " << n - merged << ", speedup = " << base / cur
+             << "\n";
+        assert(n - merged == comp);
+        for (int i = 0; i < n; i += n / 100 + 1) {
+            assert(cdsu.size(i) == dsu.size(i));
+        }
+    }
+}
+
+int main() {
+    benchmark();
+    return 0;
+}
@@ -7,51 +7,66 @@
 using namespace std;
 
 struct DLX {
-    static const int MAXN = 1e5 + 10;
-    static const int MAXM = 1e3 + 10;
-
-    int n, m, sz;              // n行m列，sz为节点总数
-    int S[MAXM];               // S[i]表示第i列有多少个1
-    int row[MAXN], col[MAXN];  // row[i], col[i]表示节点i所在的行列
-    int L[MAXN], R[MAXN], U[MAXN], D[MAXN];  // 四个方向的指针
-    int ansd, ans[MAXN];                     // 答案深度和答案数组
-
-    // 初始化
-    void init(int _n, int _m) {
+    int n, m, sz;            // n行m列，sz为节点总数
+    vector<int> S;           // S[i]表示第i列有多少个1
+    vector<int> row, col;    // row[i], col[i]表示节点i所在的行列
+    vector<int> L, R, U, D;  // 四个方向的指针
+    int ansd;                // 答案深度
+    vector<int> ans;         // 答案数组
+
+    // 初始化，primary 为主列数（默认全部）：列 1..primary 必须恰好覆盖一次，
+    // 其余为次列，至多覆盖一次，不挂在表头链上
+    void init(int _n, int _m, int primary = -1) {
         n = _n;
         m = _m;
+        if (primary < 0) {
+            primary = m;
+        }
+        S.assign(m + 1, 0);
+        row.assign(m + 1, 0);
+        col.assign(m + 1, 0);
+        L.resize(m + 1);
+        R.resize(m + 1);
+        U.resize(m + 1);
+        D.resize(m + 1);
+        ans.assign(n + 1, 0);
 
         // 初始化列头节点（0号节点为表头）
         for (int i = 0; i <= m; i++) {
-            S[i] = 0;
             U[i] = D[i] = i;
             L[i] = i - 1;
             R[i] = i + 1;
+            col[i] = i;
+        }
+        L[0] = primary;
+        R[primary] = 0;
+        // 次列左右指向自己，remove/restore 对其横向链无影响
+        for (int i = primary + 1; i <= m; i++) {
+            L[i] = R[i] = i;
         }
-        L[0] = m;
-        R[m] = 0;
         sz = m + 1;
     }
 
-    // 在第r行第c列插入一个节点
+    // 在第r行第c列插入一个节点（同一行的节点需连续插入）
     void link(int r, int c) {
-        row[sz] = r;
-        col[sz] = c;
+        row.push_back(r);
+        col.push_back(c);
         S[c]++;
 
         // 插入到第c列
-        D[sz] = D[c];
+        D.push_back(D[c]);
         U[D[c]] = sz;
-        U[sz] = c;
+        U.push_back(c);
         D[c] = sz;
 
         // 插入到第r行
         if (!row[sz - 1] || row[sz - 1] != r) {
-            L[sz] = R[sz] = sz;
+            L.push_back(sz);
+            R.push_back(sz);
         } else {
-            R[sz] = R[sz - 1];
+            R.push_back(R[sz - 1]);
             L[R[sz - 1]] = sz;
-            L[sz] = sz - 1;
+            L.push_back(sz - 1);
             R[sz - 1] = sz;
         }
 
@@ -86,21 +101,40 @@ struct DLX {
         R[L[c]] = c;
     }
 
-    // 精确覆盖求解
-    bool dance(int d) {
-        if (R[0] == 0) {
-            ansd = d;
-            return true;
-        }
-
-        // 选择S[c]最小的列（启发式剪枝）
+    // 选择S[c]最小的列（启发式剪枝）
+    int choose() const {
         int c = R[0];
         for (int i = R[0]; i != 0; i = R[i]) {
             if (S[i] < S[c]) {
                 c = i;
             }
         }
+        return c;
+    }
+
+    // 选中节点 i 所在的行（覆盖该行所有列），unselect 为其逆操作
+    void select(int i) {
+        remove(col[i]);
+        for (int j = R[i]; j != i; j = R[j]) {
+            remove(col[j]);
+        }
+    }
+
+    void unselect(int i) {
+        for (int j = L[i]; j != i; j = L[j]) {
+            restore(col[j]);
+        }
+        restore(col[i]);
+    }
+
+    // 精确覆盖求解
+    bool dance(int d) {
+        if (R[0] == 0) {
+            ansd = d;
+            return true;
+        }
 
+        int c = choose();
         remove(c);
 
         for (int i = D[c]; i != c; i = D[i]) {
@@ -123,30 +157,28 @@ struct DLX {
         return false;
     }
 
-    // 求所有解的数量
-    int count_solutions(int d) {
+    // 枚举所有解，每找到一个解调用 f(d)，此时 ans[0, d) 为选中的行；返回解的数量
+    template <class F>
+    long long search(int d, F& f) {
         if (R[0] == 0) {
+            f(d);
             return 1;
         }
 
-        int c = R[0];
-        for (int i = R[0]; i != 0; i = R[i]) {
-            if (S[i] < S[c]) {
-                c = i;
-            }
-        }
-
+        int c = choose();
         if (S[c] == 0) return 0;  // 无解
 
         remove(c);
-        int res = 0;
+        long long res = 0;
 
         for (int i = D[c]; i != c; i = D[i]) {
+            ans[d] = row[i];
+
             for (int j = R[i]; j != i; j = R[j]) {
                 remove(col[j]);
             }
 
-            res += count_solutions(d + 1);
+            res += search(d + 1, f);
 
             for (int j = L[i]; j != i; j = L[j]) {
                 restore(col[j]);
@@ -156,6 +188,107 @@ struct DLX {
         restore(c);
         return res;
     }
+
+    // 求所有解的数量
+    long long count_solutions(int d) {
+        auto f = [](int) {};
+        return search(d, f);
+    }
+
+    // 并行枚举所有解，返回解的数量
+    // 先在本对象上逐层展开搜索树顶部，直到子任务数不少于 tasksPerThread * threads，
+    // 每个子任务是从根开始依次选中的节点序列；每个线程持有一份 DLX 副本，
+    // 重放任务前缀后串行搜索，线程之间不共享节点数组
+    // 任务分到各线程的双端队列，自己的队列从尾部取，空了就从其他线程的队列头部窃取
+    // f(tid, ans, d) 在工作线程 tid 中调用，ans[0, d) 为选中的行，需自行保证线程安全
+    template <class F>
+    long long parallel_search(F&& f, int threads = 0,
+                              int tasksPerThread = 16) {
+        if (threads <= 0) {
+            threads = max(1u, thread::hardware_concurrency());
+        }
+
+        long long res = 0;
+        vector<vector<int>> tasks{{}};
+        auto replay = [](DLX& x, const vector<int>& p) {
+            for (int d = 0; d < (int)p.size(); d++) {
+                x.ans[d] = x.row[p[d]];
+                x.select(p[d]);
+            }
+        };
+        auto undo = [](DLX& x, const vector<int>& p) {
+            for (int d = p.size() - 1; d >= 0; d--) {
+                x.unselect(p[d]);
+            }
+        };
+        while (!tasks.empty() &&
+               (int)tasks.size() < tasksPerThread * threads) {
+            vector<vector<int>> next;
+            for (auto& p : tasks) {
+                replay(*this, p);
+                if (R[0] == 0) {
+                    f(0, ans, (int)p.size());
+                    res++;
+                } else if (int c = choose(); S[c]) {
+                    for (int i = D[c]; i != c; i = D[i]) {
+                        next.push_back(p);
+                        next.back().push_back(i);
+                    }
+                }
+                undo(*this, p);
+            }
+            tasks = move(next);
+        }
+
+        struct Queue {
+            mutex mu;
+            deque<int> q;
+        };
+        vector<Queue> qs(threads);
+        for (int i = 0; i < (int)tasks.size(); i++) {
+            qs[i % threads].q.push_back(i);
+        }
+        auto take = [&](int tid) {
+            for (int k = 0; k < threads; k++) {
+                Queue& cur = qs[(tid + k) % threads];
+                lock_guard lk(cur.mu);
+                if (!cur.q.empty()) {
+                    int t;
+                    if (k == 0) {
+                        t = cur.q.back();
+                        cur.q.pop_back();
+                    } else {
+                        t = cur.q.front();
+                        cur.q.pop_front();
+                    }
+                    return t;
+                }
+            }
+            return -1;
+        };
+
+        vector<long long> cnt(threads);
+        vector<thread> ths;
+        for (int tid = 0; tid < threads; tid++) {
+            ths.emplace_back([&, tid] {
+                DLX local = *this;
+                auto g = [&](int d) { f(tid, local.ans, d); };
+                for (int t; (t = take(tid)) != -1;) {
+                    replay(local, tasks[t]);
+                    cnt[tid] += local.search(tasks[t].size(), g);
+                    undo(local, tasks[t]);
+                }
+            });
+        }
+        for (auto& th : ths) {
+            th.join();
+        }
+        return res + accumulate(cnt.begin(), cnt.end(), 0LL);
+    }
+
+    long long count_parallel(int threads = 0) {
+        return parallel_search([](int, const vector<int>&, int) {}, threads);
+    }
 };
 
 // 应用1：数独求解
@@ -224,8 +357,8 @@ void solve_sudoku() {
     }
 }
 
-// 应用2：N皇后问题
-void solve_n_queens(int n) {
+// 应用2：N皇后问题（对角线为次列）
+DLX n_queens(int n) {
     DLX dlx;
 
     // 约束：
@@ -235,7 +368,7 @@ void solve_n_queens(int n) {
     // 4. 每条副对角线最多一个皇后（2n-1列）
 
     int total_cols = 2 * n + 2 * (2 * n - 1);
-    dlx.init(n * n, total_cols);
+    dlx.init(n * n, total_cols, 2 * n);
 
     for (int i = 0; i < n; i++) {
         for (int j = 0; j < n; j++) {
@@ -255,10 +388,37 @@ void solve_n_queens(int n) {
         }
     }
 
-    int solutions = dlx.count_solutions(0);
+    return dlx;
+}
+
+void solve_n_queens(int n) {
+    long long solutions = n_queens(n).count_solutions(0);
     cout << n << "-Queens: " << solutions << " solutions\n";
 }
 
+// 基准测试：N 皇后计数，串行与不同线程数的并行版本
+void benchmark(int lo = 16, int hi = 18) {
+    auto timeit = [&](auto&& fn) {
+        auto st = chrono::steady_clock::now();
+        long long res = fn();
+        double t =
+            chrono::duration<double>(chrono::steady_clock::now() - st).count();
+        return pair(t, res);
+    };
+    int hw = max(1u, thread::hardware_concurrency());
+    for (int n = lo; n <= hi; n++) {
+        DLX dlx = n_queens(n);
+        auto [t1, r1] = timeit([&] { return dlx.count_solutions(0); });
+        cout << n << "-Queens: " << r1 << " solutions, serial " << t1 << "s";
+        for (int th = 1; th <= hw; th *= 2) {
+            auto [t2, r2] = timeit([&] { return dlx.count_parallel(th); });
+            assert(r1 == r2);
+            cout << ", " << th << " threads " << t2 << "s";
+        }
+        cout << "\n";
+    }
+}
+
 // 应用3：精确覆盖问题（通用）
 void exact_cover() {
     int n, m;  // n行m列
@@ -0,0 +1,94 @@
+/**
+ * 猫树 / 不相交 ST 表 (Disjoint Sparse Table)
+ * 功能：静态区间查询，只要求运算满足结合律（乘积取模、矩阵乘、哈希拼接等）
+ * 复杂度：预处理 O(n log n)，查询 O(1) 且只做一次合并
+ * 使用方法：Info 实现结合律的 operator+，与 SegmentTree.cpp 的 Info 相同
+ */
+#include <bits/stdc++.h>
+using namespace std;
+
+template <class Info>
+struct DisjointSparseTable {
+    int n, lg;
+    vector<Info> a;
+    // tbl[h][i]：以第 h 层分界点 mid 为界，i < mid 时为 [i, mid) 的和，否则为 [mid, i]
+    vector<vector<Info>> tbl;
+
+    DisjointSparseTable() : n(0) {}
+    DisjointSparseTable(const vector<Info>& a_) : a(a_) {
+        n = a.size();
+        lg = 1;
+        while ((1 << lg) < n) {
+            lg++;
+        }
+        tbl.assign(lg, vector<Info>(n));
+        for (int h = 0; h < lg; h++) {
+            int half = 1 << h;
+            for (int mid = half; mid < n; mid += 2 * half) {
+                tbl[h][mid - 1] = a[mid - 1];
+                for (int i = mid - 2; i >= mid - half; i--) {
+                    tbl[h][i] = a[i] + tbl[h][i + 1];
+                }
+                tbl[h][mid] = a[mid];
+                for (int i = mid + 1; i < min(n, mid + half); i++) {
+                    tbl[h][i] = tbl[h][i - 1] + a[i];
+                }
+            }
+        }
+    }
+
+    Info query(int l, int r) const {  // [l, r)，要求 l < r
+        r--;
+        if (l == r) {
+            return a[l];
+        }
+        int h = __lg(l ^ r);
+        return tbl[h][l] + tbl[h][r];
+    }
+
+    // 批量查询：按层号排序后再处理，同一层的查询访问同一行，缓存更友好
+    vector<Info> query(const vector<pair<int, int>>& qs) const {
+        int q = qs.size();
+        vector<int> cnt(lg + 2), ord(q);
+        auto level = [&](int i) {
+            auto [l, r] = qs[i];
+            return l == r - 1 ? 0 : __lg(l ^ (r - 1)) + 1;
+        };
+        for (int i = 0; i < q; i++) {
+            cnt[level(i) + 1]++;
+        }
+        for (int i = 1; i <= lg + 1; i++) {
+            cnt[i] += cnt[i - 1];
+        }
+        for (int i = 0; i < q; i++) {
+            ord[cnt[level(i)]++] = i;
+        }
+        vector<Info> res(q);
+        for (int i : ord) {
+            res[i] = query(qs[i].first, qs[i].second);
+        }
+        return res;
+    }
+};
+
+// 使用示例：区间乘积取模
+const int P = 998244353;
+
+struct Info {
+    long long x = 1;
+};
+
+Info operator+(const Info& a, const Info& b) { return {a.x * b.x % P}; }
+
+void example() {
+    vector<Info> a = {{2}, {3}, {5}, {7}, {11}};
+    DisjointSparseTable<Info> dst(a);
+
+    cout << dst.query(1, 4).x << "\n";  // 3 * 5 * 7 = 105
+
+    auto res = dst.query({{0, 5}, {2, 3}, {3, 5}});
+    for (auto& v : res) {
+        cout << v.x << " ";  // 2310 5 77
+    }
+    cout << "\n";
+}
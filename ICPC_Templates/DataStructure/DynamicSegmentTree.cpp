@@ -0,0 +1,158 @@
+/**
+ * 动态开点线段树 (Dynamic Segment Tree)
+ * 功能：下标范围 [0, 2^62)，在线区间修改、区间查询，无需离散化
+ * 复杂度：单次 O(log C)，C 为值域；空间与访问过的位置数成正比
+ * 使用方法：与 SegmentTree.cpp 相同的 Info/Tag，另需给出 make(l, r)，
+ *           表示从未修改过的区间 [l, r) 的初始 Info
+ */
+#include <bits/stdc++.h>
+using namespace std;
+using ll = long long;
+
+// 示例：区间加，区间求和（len 需要 long long）
+struct Tag {
+    ll add = 0;
+
+    void apply(const Tag& t) { add += t.add; }
+};
+
+struct Info {
+    ll sum = 0;
+    ll len = 0;
+
+    void apply(const Tag& t) { sum += t.add * len; }
+};
+
+Info operator+(const Info& a, const Info& b) {
+    Info c;
+    c.sum = a.sum + b.sum;
+    c.len = a.len + b.len;
+    return c;
+}
+
+template <class Info, class Tag>
+struct DynamicSegmentTree {
+    ll lo, hi;
+    function<Info(ll, ll)> make;
+    // 节点池：下标 0 表示空节点，ls/rs 为子节点下标
+    vector<int> ls, rs;
+    vector<Info> info;
+    vector<Tag> tag;
+    int root;
+
+    DynamicSegmentTree(
+        function<Info(ll, ll)> make_ = [](ll, ll) { return Info(); },
+        ll lo_ = 0, ll hi_ = 1LL << 62, int reserve_ = 0)
+        : lo(lo_), hi(hi_), make(make_) {
+        ls.reserve(reserve_ + 1);
+        rs.reserve(reserve_ + 1);
+        info.reserve(reserve_ + 1);
+        tag.reserve(reserve_ + 1);
+        newNode(0, 0);
+        root = newNode(lo, hi);
+    }
+
+    int newNode(ll l, ll r) {
+        ls.push_back(0);
+        rs.push_back(0);
+        info.push_back(make(l, r));
+        tag.push_back(Tag());
+        return info.size() - 1;
+    }
+
+    void pull(int p) { info[p] = info[ls[p]] + info[rs[p]]; }
+
+    void apply(int p, const Tag& v) {
+        info[p].apply(v);
+        tag[p].apply(v);
+    }
+
+    // 第一次下推时才创建两个儿子
+    void push(int p, ll l, ll r) {
+        ll m = l + (r - l) / 2;
+        if (!ls[p]) {
+            int a = newNode(l, m);
+            int b = newNode(m, r);
+            ls[p] = a;
+            rs[p] = b;
+        }
+        apply(ls[p], tag[p]);
+        apply(rs[p], tag[p]);
+        tag[p] = Tag();
+    }
+
+    void modify(int p, ll l, ll r, ll x, const Info& v) {
+        if (r - l == 1) {
+            info[p] = v;
+            return;
+        }
+        ll m = l + (r - l) / 2;
+        push(p, l, r);
+        if (x < m) {
+            modify(ls[p], l, m, x, v);
+        } else {
+            modify(rs[p], m, r, x, v);
+        }
+        pull(p);
+    }
+
+    void modify(ll p, const Info& v) { modify(root, lo, hi, p, v); }
+
+    // 查询不创建节点：儿子不存在时整棵子树仍是 make 的值再叠加 tag[p]
+    Info rangeQuery(int p, ll l, ll r, ll x, ll y) {
+        if (l >= y || r <= x) {
+            return Info();
+        }
+        if (l >= x && r <= y) {
+            return info[p];
+        }
+        if (!ls[p]) {
+            Info res = make(max(l, x), min(r, y));
+            res.apply(tag[p]);
+            return res;
+        }
+        ll m = l + (r - l) / 2;
+        push(p, l, r);
+        return rangeQuery(ls[p], l, m, x, y) + rangeQuery(rs[p], m, r, x, y);
+    }
+
+    Info rangeQuery(ll l, ll r) { return rangeQuery(root, lo, hi, l, r); }
+
+    void rangeApply(int p, ll l, ll r, ll x, ll y, const Tag& v) {
+        if (l >= y || r <= x) {
+            return;
+        }
+        if (l >= x && r <= y) {
+            apply(p, v);
+            return;
+        }
+        ll m = l + (r - l) / 2;
+        push(p, l, r);
+        rangeApply(ls[p], l, m, x, y, v);
+        rangeApply(rs[p], m, r, x, y, v);
+        pull(p);
+    }
+
+    void rangeApply(ll l, ll r, const Tag& v) {
+        rangeApply(root, lo, hi, l, r, v);
+    }
+
+    int nodeCount() const { return info.size() - 1; }
+};
+
+// 使用示例：时间戳为下标的在线区间加、区间和
+void example() {
+    DynamicSegmentTree<Info, Tag> seg([](ll l, ll r) {
+        Info v;
+        v.len = r - l;
+        return v;
+    });
+
+    seg.rangeApply(1000000000000LL, 3000000000000LL, Tag{2});
+    seg.rangeApply(2000000000000LL, 2000000000010LL, Tag{5});
+
+    // 2 * 10 + 5 * 10 = 70
+    cout << seg.rangeQuery(2000000000000LL, 2000000000010LL).sum << "\n";
+    // 2 * 2e12 + 5 * 10
+    cout << seg.rangeQuery(0, 1LL << 62).sum << "\n";
+}
@@ -2,13 +2,57 @@
  * 分数类 (Fraction)
  * 功能：精确分数运算
  * 应用：需要精确除法的场景
+ * 中间结果用更宽的类型 W 计算（int -> ll，ll -> __int128），
+ * 分子分母超过阈值 LIM 时才用二进制 GCD 约分（惰性约分）；
+ * LIM 保证两次乘积之和不会溢出 W，因此存储值可以不是最简形式
+ * 若约分后仍超过 LIM，说明真实结果本身就存不下，此时 assert 失败而不是静默截断
  */
 #include <bits/stdc++.h>
 using namespace std;
 using ll = long long;
+using i128 = __int128;
+using u128 = unsigned __int128;
+
+template <class U>
+int ctz(U x) {
+    if constexpr (sizeof(U) <= 8) {
+        return __builtin_ctzll(x);
+    } else {
+        unsigned long long lo = x;
+        return lo ? __builtin_ctzll(lo) : 64 + __builtin_ctzll(x >> 64);
+    }
+}
+
+// 二进制 GCD（Stein 算法），只用移位和减法，比取模快
+template <class U>
+U binary_gcd(U a, U b) {
+    if (a == 0) {
+        return b;
+    }
+    if (b == 0) {
+        return a;
+    }
+    int s = ctz(a | b);
+    a >>= ctz(a);
+    do {
+        b >>= ctz(b);
+        if (a > b) {
+            swap(a, b);
+        }
+        b -= a;
+    } while (b);
+    return a << s;
+}
 
 template <class T>
 struct Frac {
+    using W = conditional_t<sizeof(T) <= 4, ll, i128>;
+    using U = conditional_t<sizeof(W) <= 8, unsigned long long, u128>;
+    // LIM = min(T 的最大值, 2^((W 的位数 - 2) / 2) - 1)
+    static constexpr W LIM =
+        min<W>(W(numeric_limits<T>::max()),
+               (W(1) << ((sizeof(W) * 8 - 2) / 2)) - 1);
+
     T num;
     T den;
 
@@ -23,31 +67,60 @@ struct Frac {
 
     explicit operator double() const { return 1. * num / den; }
 
+    static U uabs(W x) { return x < 0 ? -U(x) : U(x); }
+
+    // 要求 d > 0；超过阈值时约分，约分后仍超过阈值则溢出
+    void assign(W n, W d) {
+        if (n > LIM || n < -LIM || d > LIM) {
+            W g = binary_gcd(uabs(n), U(d));
+            n /= g;
+            d /= g;
+            assert(n <= LIM && n >= -LIM && d <= LIM);  // 结果本身存不下
+        }
+        num = n;
+        den = d;
+    }
+
+    // 化为最简形式
+    Frac& normalize() {
+        T g = binary_gcd(uabs(num), U(den));
+        if (g > 1) {
+            num /= g;
+            den /= g;
+        }
+        return *this;
+    }
+
     Frac& operator+=(const Frac& rhs) {
-        num = num * rhs.den + rhs.num * den;
-        den *= rhs.den;
+        if (den == rhs.den) {
+            assign(W(num) + rhs.num, den);
+        } else {
+            assign(W(num) * rhs.den + W(rhs.num) * den, W(den) * rhs.den);
+        }
         return *this;
     }
 
     Frac& operator-=(const Frac& rhs) {
-        num = num * rhs.den - rhs.num * den;
-        den *= rhs.den;
+        if (den == rhs.den) {
+            assign(W(num) - rhs.num, den);
+        } else {
+            assign(W(num) * rhs.den - W(rhs.num) * den, W(den) * rhs.den);
+        }
         return *this;
     }
 
     Frac& operator*=(const Frac& rhs) {
-        num *= rhs.num;
-        den *= rhs.den;
+        assign(W(num) * rhs.num, W(den) * rhs.den);
         return *this;
     }
 
     Frac& operator/=(const Frac& rhs) {
-        num *= rhs.den;
-        den *= rhs.num;
-        if (den < 0) {
-            num = -num;
-            den = -den;
+        W n = W(num) * rhs.den, d = W(den) * rhs.num;
+        if (d < 0) {
+            n = -n;
+            d = -d;
         }
+        assign(n, d);
         return *this;
     }
 
@@ -61,36 +134,135 @@ struct Frac {
 
     friend Frac operator-(const Frac& a) { return Frac(-a.num, a.den); }
 
+    static int sgn(T x) { return (x > 0) - (x < 0); }
+
+    // 三路比较：先比符号，分母相同时直接比分子，最后才做 W 上的交叉相乘
+    friend int compare(const Frac& lhs, const Frac& rhs) {
+        int sl = sgn(lhs.num), sr = sgn(rhs.num);
+        if (sl != sr) {
+            return sl < sr ? -1 : 1;
+        }
+        if (sl == 0) {
+            return 0;
+        }
+        if (lhs.den == rhs.den) {
+            return lhs.num < rhs.num ? -1 : lhs.num > rhs.num;
+        }
+        W a = W(lhs.num) * rhs.den, b = W(rhs.num) * lhs.den;
+        return a < b ? -1 : a > b;
+    }
+
     friend bool operator==(const Frac& lhs, const Frac& rhs) {
-        return lhs.num * rhs.den == rhs.num * lhs.den;
+        return compare(lhs, rhs) == 0;
     }
 
     friend bool operator!=(const Frac& lhs, const Frac& rhs) {
-        return lhs.num * rhs.den != rhs.num * lhs.den;
+        return compare(lhs, rhs) != 0;
     }
 
+    // 排序用的 < 只需一次比较，交叉相乘在 W 上进行不会溢出
     friend bool operator<(const Frac& lhs, const Frac& rhs) {
-        return lhs.num * rhs.den < rhs.num * lhs.den;
+        return W(lhs.num) * rhs.den < W(rhs.num) * lhs.den;
     }
 
     friend bool operator>(const Frac& lhs, const Frac& rhs) {
-        return lhs.num * rhs.den > rhs.num * lhs.den;
+        return compare(lhs, rhs) > 0;
     }
 
     friend bool operator<=(const Frac& lhs, const Frac& rhs) {
-        return lhs.num * rhs.den <= rhs.num * lhs.den;
+        return compare(lhs, rhs) <= 0;
     }
 
     friend bool operator>=(const Frac& lhs, const Frac& rhs) {
-        return lhs.num * rhs.den >= rhs.num * lhs.den;
+        return compare(lhs, rhs) >= 0;
     }
 
     friend ostream& operator<<(ostream& os, Frac x) {
-        T g = gcd(x.num, x.den);
-        if (x.den == g) {
-            return os << x.num / g;
+        x.normalize();
+        if (x.den == 1) {
+            return os << x.num;
         } else {
-            return os << x.num / g << "/" << x.den / g;
+            return os << x.num << "/" << x.den;
         }
     }
 };
+
+// 对大量分数排序：按 double 近似值的高 48 位做 4 趟 12 位基数排序，
+// 再对近似值相邻、可能排错的段用精确比较重排
+// 精确大小相反的两个分数，其 double 只差几个 ulp，截断后的键至多差 1
+template <class T>
+void sort_fracs(vector<Frac<T>>& a) {
+    int n = a.size();
+    vector<pair<unsigned long long, int>> k(n), tmp(n);
+    for (int i = 0; i < n; i++) {
+        double d = double(a[i].num) / double(a[i].den);
+        unsigned long long u;
+        memcpy(&u, &d, 8);
+        // 映射为单调的无符号整数：负数取反，非负数置最高位
+        u = (u >> 63) ? ~u : u | (1ULL << 63);
+        k[i] = {u >> 16, i};
+    }
+    for (int sh = 0; sh < 48; sh += 12) {
+        vector<int> cnt((1 << 12) + 1);
+        for (auto& [u, i] : k) {
+            cnt[(u >> sh & 0xfff) + 1]++;
+        }
+        for (int i = 0; i < (1 << 12); i++) {
+            cnt[i + 1] += cnt[i];
+        }
+        for (auto& x : k) {
+            tmp[cnt[x.first >> sh & 0xfff]++] = x;
+        }
+        swap(k, tmp);
+    }
+    vector<Frac<T>> b(n);
+    for (int i = 0; i < n; i++) {
+        b[i] = a[k[i].second];
+    }
+    for (int l = 0, r; l < n; l = r) {
+        r = l + 1;
+        while (r < n && k[r].first - k[r - 1].first <= 1) {
+            r++;
+        }
+        if (r - l > 1) {
+            sort(b.begin() + l, b.begin() + r);
+        }
+    }
+    a = move(b);
+}
+
+// 排序 n 条线段的斜率 dy/dx（坐标不超过 1e9，dx != 0），
+// 与直接在 ll 上交叉相乘的旧写法对比
+void benchmark(int n = 10000000) {
+    mt19937_64 rng(20251017);
+    vector<Frac<ll>> a(n);
+    for (auto& f : a) {
+        ll dy = (ll)(rng() % 2000000001) - 1000000000;
+        ll dx = (ll)(rng() % 2000000001) - 1000000000;
+        f = Frac<ll>(dy, dx ? dx : 1);
+    }
+    auto b = a, c = a;
+
+    auto st = chrono::steady_clock::now();
+    sort(a.begin(), a.end());
+    double t1 =
+        chrono::duration<double>(chrono::steady_clock::now() - st).count();
+
+    st = chrono::steady_clock::now();
+    sort_fracs(c);
+    double t3 =
+        chrono::duration<double>(chrono::steady_clock::now() - st).count();
+
+    st = chrono::steady_clock::now();
+    sort(b.begin(), b.end(), [](const Frac<ll>& x, const Frac<ll>& y) {
+        return x.num * y.den < y.num * x.den;
+    });
+    double t2 =
+        chrono::duration<double>(chrono::steady_clock::now() - st).count();
+
+    for (int i = 0; i < n; i++) {
+        assert(compare(a[i], c[i]) == 0 && compare(a[i], b[i]) == 0);
+    }
+    cout << "sort: " << t1 << "s, sort_fracs: " << t3
+         << "s, old cross multiply: " << t2 << "s\n";
+}
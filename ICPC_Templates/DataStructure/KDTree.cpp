@@ -2,6 +2,9 @@
 // 功能：多维空间中的最近邻查询、范围查询
 // 复杂度：构建 O(n log n), 查询平均 O(log n), 最坏 O(n)
 // 应用：最近邻搜索、k近邻、范围统计
+// DynamicKDTree 为动态版本：维度运行时给定，支持插入、删除（替罪羊式重构）、
+// k 近邻与矩形范围查询；查询为 const 且不使用全局状态，可多线程并发调用
+// BucketKDTree 为静态分桶版本：叶子存 SoA 坐标块，距离计算可向量化，支持批量最近点查询
 
 #include <bits/stdc++.h>
 using namespace std;
@@ -28,12 +31,6 @@ struct KDTree {
     int split[MAXN];  // 每个节点的分割维度
     int n;
 
-    // 按第 d 维排序
-    static int cmp_dim;
-    static bool cmp(const Point& a, const Point& b) {
-        return a.x[cmp_dim] < b.x[cmp_dim];
-    }
-
     // 构建KD树
     void build(int l, int r) {
         if (l >= r) return;
@@ -63,15 +60,18 @@ struct KDTree {
             }
         }
 
-        cmp_dim = split[mid];
-        nth_element(pts + l, pts + mid, pts + r + 1, cmp);
+        int d = split[mid];
+        nth_element(pts + l, pts + mid, pts + r + 1,
+                    [&](const Point& a, const Point& b) {
+                        return a.x[d] < b.x[d];
+                    });
 
         build(l, mid - 1);
         build(mid + 1, r);
     }
 
     // 查询最近点
-    int ans_id;
+    int ans_id, ans_pos;  // 建树时 pts 已被重排，返回时需用下标而不是编号
     long long ans_dist;
 
     void query(int l, int r, const Point& p) {
@@ -84,6 +84,7 @@ struct KDTree {
         if (d < ans_dist || (d == ans_dist && pts[mid].id < ans_id)) {
             ans_dist = d;
             ans_id = pts[mid].id;
+            ans_pos = mid;
         }
 
         // 剪枝：先搜索更可能包含答案的子树
@@ -108,11 +109,582 @@ struct KDTree {
         ans_dist = INF;
         ans_id = -1;
         query(0, n - 1, p);
-        return pts[ans_id];
+        return pts[ans_pos];
+    }
+};
+
+// 动态 KD 树：每个点即一个节点，节点编号等于 insert 返回的点编号
+// 删除只打标记，被删点在所在子树重构时丢弃并回收其编号，之后 insert 会复用；
+// 因此 erase 过的编号不能再使用（可能已分配给新点）；
+// 节点数组大小不超过存活点数峰值的约两倍
+// 包围盒含已删点，只会使剪枝偏松
+// 插入后若某节点一侧子树大小超过 ALPHA 倍则重构该子树（取路径上最高的一个），
+// 已删点超过一半时重构整棵树
+// 坐标为 long long，要求任意两点距离平方不超过 long long 范围
+// 查询与修改不能同时进行；只有查询时可多线程并发
+struct DynamicKDTree {
+    static constexpr double ALPHA = 0.75;
+
+    // 查询时同一节点的字段一起访问，按节点连续存放
+    struct Node {
+        int ls = -1, rs = -1, fa = -1, dim = 0;
+        int siz = 1, cnt = 1;  // siz 含已删点，cnt 不含
+        bool del = false;
+    };
+
+    int k, root = -1, alive = 0;
+    vector<Node> t;
+    vector<long long> data;  // 每个节点 3k 个数：坐标、包围盒下界、包围盒上界
+    vector<int> freeIds;     // 重构时丢弃的已删节点，供 newNode 复用
+
+    DynamicKDTree(int k_) : k(k_) {}
+
+    // 批量建树，点编号依次为 0..m-1
+    DynamicKDTree(int k_, const vector<vector<long long>>& pts) : k(k_) {
+        t.reserve(pts.size());
+        data.reserve(pts.size() * 3 * k);
+        for (auto& p : pts) {
+            newNode(p.data());
+        }
+        vector<int> ids(pts.size());
+        iota(ids.begin(), ids.end(), 0);
+        root = build(ids, 0, ids.size(), -1);
+    }
+
+    int size() const { return alive; }
+    const long long* point(int u) const { return &data[3LL * k * u]; }
+    long long* lo(int u) { return &data[3LL * k * u + k]; }
+    long long* hi(int u) { return &data[3LL * k * u + 2 * k]; }
+    const long long* lo(int u) const { return &data[3LL * k * u + k]; }
+    const long long* hi(int u) const { return &data[3LL * k * u + 2 * k]; }
+
+    int newNode(const long long* p) {
+        alive++;
+        if (!freeIds.empty()) {
+            int u = freeIds.back();
+            freeIds.pop_back();
+            t[u] = Node();
+            for (int i = 0; i < 3; i++) {
+                copy_n(p, k, &data[3LL * k * u + i * k]);
+            }
+            return u;
+        }
+        t.emplace_back();
+        for (int i = 0; i < 3; i++) {
+            data.insert(data.end(), p, p + k);
+        }
+        return t.size() - 1;
+    }
+
+    void pull(int u) {
+        Node& x = t[u];
+        x.siz = 1;
+        x.cnt = !x.del;
+        copy_n(point(u), k, lo(u));
+        copy_n(point(u), k, hi(u));
+        for (int c : {x.ls, x.rs}) {
+            if (c == -1) {
+                continue;
+            }
+            x.siz += t[c].siz;
+            x.cnt += t[c].cnt;
+            for (int d = 0; d < k; d++) {
+                lo(u)[d] = min(lo(u)[d], lo(c)[d]);
+                hi(u)[d] = max(hi(u)[d], hi(c)[d]);
+            }
+        }
+    }
+
+    // 在 ids[l, r) 上建树，按方差最大的维度划分
+    int build(vector<int>& ids, int l, int r, int parent) {
+        if (l >= r) {
+            return -1;
+        }
+        int mid = (l + r) / 2, best = 0;
+        double maxVar = -1;
+        for (int d = 0; d < k; d++) {
+            double avg = 0, var = 0;
+            for (int i = l; i < r; i++) {
+                avg += point(ids[i])[d];
+            }
+            avg /= r - l;
+            for (int i = l; i < r; i++) {
+                double x = point(ids[i])[d] - avg;
+                var += x * x;
+            }
+            if (var > maxVar) {
+                maxVar = var;
+                best = d;
+            }
+        }
+        nth_element(
+            ids.begin() + l, ids.begin() + mid, ids.begin() + r,
+            [&](int a, int b) { return point(a)[best] < point(b)[best]; });
+        int u = ids[mid];
+        t[u].dim = best;
+        t[u].fa = parent;
+        t[u].ls = build(ids, l, mid, u);
+        t[u].rs = build(ids, mid + 1, r, u);
+        pull(u);
+        return u;
+    }
+
+    // 收集子树内的存活点，已删点的编号放入 freeIds
+    void flatten(int u, vector<int>& ids) {
+        if (u == -1) {
+            return;
+        }
+        flatten(t[u].ls, ids);
+        if (!t[u].del) {
+            ids.push_back(u);
+        } else {
+            freeIds.push_back(u);
+        }
+        flatten(t[u].rs, ids);
+    }
+
+    void rebuild(int u) {
+        int p = t[u].fa;
+        vector<int> ids;
+        flatten(u, ids);
+        int v = build(ids, 0, ids.size(), p);
+        if (p == -1) {
+            root = v;
+        } else if (t[p].ls == u) {
+            t[p].ls = v;
+        } else {
+            t[p].rs = v;
+        }
+    }
+
+    int insert(const vector<long long>& p) {
+        int id = newNode(p.data());
+        if (root == -1) {
+            root = id;
+            return id;
+        }
+        int u = root;
+        while (true) {
+            t[u].siz++;
+            t[u].cnt++;
+            for (int d = 0; d < k; d++) {
+                lo(u)[d] = min(lo(u)[d], p[d]);
+                hi(u)[d] = max(hi(u)[d], p[d]);
+            }
+            int& c = p[t[u].dim] < point(u)[t[u].dim] ? t[u].ls : t[u].rs;
+            if (c == -1) {
+                c = id;
+                t[id].fa = u;
+                break;
+            }
+            u = c;
+        }
+        int bad = -1;
+        for (int v = t[id].fa; v != -1; v = t[v].fa) {
+            int l = t[v].ls, r = t[v].rs;
+            int mx = max(l == -1 ? 0 : t[l].siz, r == -1 ? 0 : t[r].siz);
+            if (mx > ALPHA * t[v].siz) {
+                bad = v;
+            }
+        }
+        if (bad != -1) {
+            rebuild(bad);
+        }
+        return id;
+    }
+
+    // 删除编号为 id 的点，已删除时返回 false
+    bool erase(int id) {
+        if (t[id].del) {
+            return false;
+        }
+        t[id].del = true;
+        alive--;
+        for (int u = id; u != -1; u = t[u].fa) {
+            t[u].cnt--;
+        }
+        if (t[root].cnt * 2 < t[root].siz) {
+            rebuild(root);
+        }
+        return true;
+    }
+
+    long long dist(int u, const long long* p) const {
+        const long long* x = point(u);
+        long long res = 0;
+        for (int d = 0; d < k; d++) {
+            res += (x[d] - p[d]) * (x[d] - p[d]);
+        }
+        return res;
+    }
+
+    // 点 p 到 u 子树包围盒的距离平方
+    long long boxDist(int u, const long long* p) const {
+        const long long *a = lo(u), *b = hi(u);
+        long long res = 0;
+        for (int d = 0; d < k; d++) {
+            long long x = max({0LL, a[d] - p[d], p[d] - b[d]});
+            res += x * x;
+        }
+        return res;
+    }
+
+    using Heap = priority_queue<pair<long long, int>>;
+
+    void knn(int u, const long long* p, int m, Heap& h) const {
+        if (u == -1 || !t[u].cnt ||
+            ((int)h.size() == m && boxDist(u, p) > h.top().first)) {
+            return;
+        }
+        if (!t[u].del) {
+            h.push({dist(u, p), u});
+            if ((int)h.size() > m) {
+                h.pop();
+            }
+        }
+        int a = t[u].ls, b = t[u].rs;
+        if (p[t[u].dim] >= point(u)[t[u].dim]) {
+            swap(a, b);
+        }
+        knn(a, p, m, h);
+        knn(b, p, m, h);
+    }
+
+    // 距离 p 最近的 m 个点，按 (距离平方, 编号) 升序
+    vector<pair<long long, int>> knn(const vector<long long>& p, int m) const {
+        Heap h;
+        if (m > 0) {
+            knn(root, p.data(), m, h);
+        }
+        vector<pair<long long, int>> res(h.size());
+        for (int i = res.size() - 1; i >= 0; i--) {
+            res[i] = h.top();
+            h.pop();
+        }
+        return res;
+    }
+
+    // 0: u 的包围盒与 [a, b] 不交，1: 部分相交，2: 被包含
+    int relation(int u, const long long* a, const long long* b) const {
+        bool inside = true;
+        for (int d = 0; d < k; d++) {
+            long long l = lo(u)[d], r = hi(u)[d];
+            if (r < a[d] || l > b[d]) {
+                return 0;
+            }
+            inside &= a[d] <= l && r <= b[d];
+        }
+        return inside ? 2 : 1;
+    }
+
+    bool contains(int u, const long long* a, const long long* b) const {
+        for (int d = 0; d < k; d++) {
+            if (point(u)[d] < a[d] || point(u)[d] > b[d]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int boxCount(int u, const long long* a, const long long* b) const {
+        if (u == -1 || !t[u].cnt) {
+            return 0;
+        }
+        int rel = relation(u, a, b);
+        if (rel != 1) {
+            return rel ? t[u].cnt : 0;
+        }
+        return (!t[u].del && contains(u, a, b)) + boxCount(t[u].ls, a, b) +
+               boxCount(t[u].rs, a, b);
+    }
+
+    // 各维都满足 a[d] <= x[d] <= b[d] 的点数
+    int boxCount(const vector<long long>& a, const vector<long long>& b) const {
+        return boxCount(root, a.data(), b.data());
+    }
+
+    template <class F>
+    void boxReport(int u, const long long* a, const long long* b, F& f) const {
+        if (u == -1 || !t[u].cnt || !relation(u, a, b)) {
+            return;
+        }
+        if (!t[u].del && contains(u, a, b)) {
+            f(u);
+        }
+        boxReport(t[u].ls, a, b, f);
+        boxReport(t[u].rs, a, b, f);
+    }
+
+    // 矩形内所有点的编号
+    vector<int> boxQuery(const vector<long long>& a,
+                         const vector<long long>& b) const {
+        vector<int> res;
+        auto f = [&](int u) { res.push_back(u); };
+        boxReport(root, a.data(), b.data(), f);
+        return res;
     }
 };
 
-int KDTree::cmp_dim = 0;
+// 叶子分桶的静态 KD 树：点按树序重排，各维坐标分开连续存放（SoA），
+// 每个叶子是各维数组上的一段 [l, r)，至多 LEAF 个点
+// 叶内距离与子树包围盒距离都是定长、无分支的循环，-O3 -march=native 下可向量化
+// 坐标绝对值需小于 2^30，使坐标差不溢出 int
+template <int D = K, int LEAF = 32>
+struct BucketKDTree {
+    struct Node {
+        int lo[D], hi[D];
+        int l, r, ch[2];  // 叶子的 ch 为 -1
+    };
+
+    vector<Node> t;
+    vector<int> c[D];  // 树序下第 d 维坐标
+    vector<int> id;    // 树序下标 -> 原编号
+
+    BucketKDTree(const vector<array<int, D>>& pts) {
+        int n = pts.size();
+        id.resize(n);
+        iota(id.begin(), id.end(), 0);
+        t.reserve(2 * (n / (LEAF / 2) + 1));
+        if (n) {
+            build(pts, 0, n);
+        }
+        for (int d = 0; d < D; d++) {
+            c[d].resize(n);
+            for (int i = 0; i < n; i++) {
+                c[d][i] = pts[id[i]][d];
+            }
+        }
+    }
+
+    // 按包围盒最宽的维度取中位数划分
+    int build(const vector<array<int, D>>& pts, int l, int r) {
+        int u = t.size();
+        t.emplace_back();
+        Node x;
+        x.l = l, x.r = r;
+        x.ch[0] = x.ch[1] = -1;
+        for (int d = 0; d < D; d++) {
+            x.lo[d] = INT_MAX, x.hi[d] = INT_MIN;
+        }
+        for (int i = l; i < r; i++) {
+            for (int d = 0; d < D; d++) {
+                x.lo[d] = min(x.lo[d], pts[id[i]][d]);
+                x.hi[d] = max(x.hi[d], pts[id[i]][d]);
+            }
+        }
+        if (r - l > LEAF) {
+            int best = 0;
+            for (int d = 1; d < D; d++) {
+                if (x.hi[d] - x.lo[d] > x.hi[best] - x.lo[best]) {
+                    best = d;
+                }
+            }
+            int mid = (l + r) / 2;
+            nth_element(
+                id.begin() + l, id.begin() + mid, id.begin() + r,
+                [&](int a, int b) { return pts[a][best] < pts[b][best]; });
+            x.ch[0] = build(pts, l, mid);
+            x.ch[1] = build(pts, mid, r);
+        }
+        t[u] = x;
+        return u;
+    }
+
+    long long boxDist(int u, const int* q) const {
+        long long res = 0;
+        for (int d = 0; d < D; d++) {
+            long long x = max({0, t[u].lo[d] - q[d], q[d] - t[u].hi[d]});
+            res += x * x;
+        }
+        return res;
+    }
+
+    // 先整段算出叶内距离，再挑出 (距离, 编号) 最小者
+    void scanLeaf(int u, const int* q, pair<long long, int>& best) const {
+        int l = t[u].l, len = t[u].r - l;
+        long long dist[LEAF];
+        for (int i = 0; i < len; i++) {
+            long long s = 0;
+            for (int d = 0; d < D; d++) {
+                int x = c[d][l + i] - q[d];
+                s += (long long)x * x;
+            }
+            dist[i] = s;
+        }
+        for (int i = 0; i < len; i++) {
+            if (dist[i] <= best.first) {
+                best = min(best, {dist[i], id[l + i]});
+            }
+        }
+    }
+
+    void query(int u, const int* q, pair<long long, int>& best) const {
+        if (t[u].ch[0] == -1) {
+            scanLeaf(u, q, best);
+            return;
+        }
+        int a = t[u].ch[0], b = t[u].ch[1];
+        long long da = boxDist(a, q), db = boxDist(b, q);
+        if (db < da) {
+            swap(a, b);
+            swap(da, db);
+        }
+        if (da <= best.first) {
+            query(a, q, best);
+        }
+        if (db <= best.first) {
+            query(b, q, best);
+        }
+    }
+
+    // 最近点的 (距离平方, 原编号)，距离相同取编号最小者
+    pair<long long, int> nearest(const array<int, D>& q) const {
+        pair<long long, int> best{LLONG_MAX, -1};
+        if (!t.empty()) {
+            query(0, q.data(), best);
+        }
+        return best;
+    }
+
+    // 批量查询：按 Morton 序处理，相邻询问访问的节点与叶子大多相同
+    vector<pair<long long, int>> nearest(const vector<array<int, D>>& qs) const {
+        int m = qs.size();
+        constexpr int BITS = 64 / D < 31 ? 64 / D : 31;
+        vector<pair<unsigned long long, int>> ord(m);
+        for (int i = 0; i < m; i++) {
+            unsigned long long key = 0;
+            for (int b = 30; b > 30 - BITS; b--) {
+                for (int d = 0; d < D; d++) {
+                    key = key << 1 | ((qs[i][d] + (1u << 30)) >> b & 1);
+                }
+            }
+            ord[i] = {key, i};
+        }
+        sort(ord.begin(), ord.end());
+        vector<pair<long long, int>> res(m);
+        for (auto [key, i] : ord) {
+            res[i] = nearest(qs[i]);
+        }
+        return res;
+    }
+};
+
+// 基准测试：单线程随机插入/删除，随后多线程并发 k 近邻查询
+void benchmarkDynamic(int k = 2, int n = 1000000, int updates = 100000,
+               int queries = 1000000, int m = 4) {
+    mt19937_64 rng(20251017);
+    auto rnd = [&] {
+        vector<long long> p(k);
+        for (auto& x : p) {
+            x = rng() % 1000000000;
+        }
+        return p;
+    };
+    vector<vector<long long>> pts(n);
+    for (auto& p : pts) {
+        p = rnd();
+    }
+    DynamicKDTree t(k, pts);
+
+    auto st = chrono::steady_clock::now();
+    for (int i = 0; i < updates; i++) {
+        if (i & 1) {
+            t.erase(rng() % t.t.size());
+        } else {
+            t.insert(rnd());
+        }
+    }
+    double tu =
+        chrono::duration<double>(chrono::steady_clock::now() - st).count();
+
+    vector<vector<long long>> qs(queries);
+    for (auto& q : qs) {
+        q = rnd();
+    }
+    int threads = max(1u, thread::hardware_concurrency());
+    vector<long long> chk(threads);
+    st = chrono::steady_clock::now();
+    vector<thread> ths;
+    for (int c = 0; c < threads; c++) {
+        ths.emplace_back([&, c] {
+            for (int i = c; i < queries; i += threads) {
+                chk[c] += t.knn(qs[i], m).back().first;
+            }
+        });
+    }
+    for (auto& th : ths) {
+        th.join();
+    }
+    double tq =
+        chrono::duration<double>(chrono::steady_clock::now() - st).count();
+    cout << updates / tu << " updates/s, " << queries / tq << " " << m
+         << "-NN queries/s on " << threads << " threads\n";
+}
+
+// 基准测试：与 KDTree 比较单次最近点查询，再在大规模点集上比较单次与批量查询
+void benchmarkBucket(int n = MAXN - 10, int big = 10000000,
+                     int queries = 1000000) {
+    mt19937 rng(20251017);
+    auto rnd = [&] {
+        array<int, K> p;
+        for (auto& x : p) {
+            x = rng() % 1000000000;
+        }
+        return p;
+    };
+    auto timeit = [&](auto&& fn) {
+        auto st = chrono::steady_clock::now();
+        fn();
+        return chrono::duration<double>(chrono::steady_clock::now() - st)
+            .count();
+    };
+    vector<array<int, K>> qs(queries);
+    for (auto& q : qs) {
+        q = rnd();
+    }
+
+    vector<array<int, K>> pts(n);
+    auto tree = make_unique<KDTree>();
+    tree->n = n;
+    for (int i = 0; i < n; i++) {
+        pts[i] = rnd();
+        copy_n(pts[i].begin(), K, tree->pts[i].x);
+        tree->pts[i].id = i;
+    }
+    tree->build(0, n - 1);
+    BucketKDTree<K> bt(pts);
+    long long c1 = 0, c2 = 0;
+    double t1 = timeit([&] {
+        for (auto& q : qs) {
+            Point p;
+            copy_n(q.begin(), K, p.x);
+            c1 += tree->find_nearest(p).id;
+        }
+    });
+    double t2 = timeit([&] {
+        for (auto& q : qs) {
+            c2 += bt.nearest(q).second;
+        }
+    });
+    assert(c1 == c2);
+    cout << "n = " << n << ": KDTree " << t1 << "s, BucketKDTree " << t2
+         << "s\n";
+
+    pts.resize(big);
+    for (auto& p : pts) {
+        p = rnd();
+    }
+    BucketKDTree<K> large(pts);
+    vector<pair<long long, int>> r1(queries), r2;
+    t1 = timeit([&] {
+        for (int i = 0; i < queries; i++) {
+            r1[i] = large.nearest(qs[i]);
+        }
+    });
+    t2 = timeit([&] { r2 = large.nearest(qs); });
+    assert(r1 == r2);
+    cout << "n = " << big << ": single " << t1 << "s, batch " << t2 << "s\n";
+}
 
 // 使用示例
 void solve() {
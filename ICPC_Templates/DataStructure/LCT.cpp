@@ -2,6 +2,8 @@
  * Link-Cut Tree (LCT)
  * 功能：动态树，支持链接、切断、路径查询等
  * 复杂度：O(log n) 均摊
+ * 指针版本只维护路径和；LinkCutTree<Info, Tag> 为数组版本，节点存放在连续数组中，
+ * 路径聚合与路径修改由 Info/Tag 给出（与 SegmentTree.cpp 相同的约定）
  */
 #include <bits/stdc++.h>
 using namespace std;
@@ -122,3 +124,272 @@ bool connected(Node* x, Node* y) {
     while (x->p) x = x->p;
     return x == y;
 }
+
+// 数组版 LCT：节点编号 0..n-1，内部下标整体加一，0 作为空节点
+// Info 需要 operator+、apply(Tag)、reverse()（翻转路径方向，满足交换律时为空）
+template <class Info, class Tag>
+struct LinkCutTree {
+    // splay 时同一节点的各字段总是一起访问，按节点连续存放比分成多个数组更快
+    struct Vertex {
+        int ch[2]{}, p = 0;
+        bool rev = false, tagged = false;
+        Info val, sum;
+        Tag tag;
+    };
+
+    int n;
+    vector<Vertex> t;
+    vector<int> stk;
+
+    LinkCutTree() : n(0) {}
+    LinkCutTree(int n_, Info v_ = Info()) { init(vector(n_, v_)); }
+    LinkCutTree(const vector<Info>& init_) { init(init_); }
+
+    void init(const vector<Info>& init_) {
+        n = init_.size();
+        t.assign(n + 1, Vertex());
+        stk.assign(n + 1, 0);
+        for (int i = 0; i < n; i++) {
+            t[i + 1].val = t[i + 1].sum = init_[i];
+        }
+    }
+
+    bool isroot(int x) const {
+        const Vertex& q = t[t[x].p];
+        return q.ch[0] != x && q.ch[1] != x;
+    }
+
+    int pos(int x) const { return t[t[x].p].ch[1] == x; }
+
+    void pull(int x) {
+        t[x].sum = t[t[x].ch[0]].sum + t[x].val + t[t[x].ch[1]].sum;
+    }
+
+    void reverse(int x) {
+        swap(t[x].ch[0], t[x].ch[1]);
+        t[x].sum.reverse();
+        t[x].rev ^= 1;
+    }
+
+    void apply(int x, const Tag& v) {
+        t[x].val.apply(v);
+        t[x].sum.apply(v);
+        t[x].tag.apply(v);
+        t[x].tagged = true;
+    }
+
+    void push(int x) {
+        if (t[x].rev) {
+            for (int c : t[x].ch) {
+                if (c) reverse(c);
+            }
+            t[x].rev = false;
+        }
+        if (t[x].tagged) {
+            for (int c : t[x].ch) {
+                if (c) apply(c, t[x].tag);
+            }
+            t[x].tag = Tag();
+            t[x].tagged = false;
+        }
+    }
+
+    void rotate(int x) {
+        int q = t[x].p, g = t[q].p;
+        int d = !pos(x);
+        if (!isroot(q)) {
+            t[g].ch[pos(q)] = x;
+        }
+        t[x].p = g;
+        t[q].ch[!d] = t[x].ch[d];
+        if (t[x].ch[d]) {
+            t[t[x].ch[d]].p = q;
+        }
+        t[x].ch[d] = q;
+        t[q].p = x;
+        pull(q);
+    }
+
+    void splay(int x) {
+        int top = 0;
+        stk[top++] = x;
+        for (int i = x; !isroot(i); i = t[i].p) {
+            stk[top++] = t[i].p;
+        }
+        while (top) {
+            push(stk[--top]);
+        }
+        while (!isroot(x)) {
+            int q = t[x].p;
+            if (!isroot(q)) {
+                rotate(pos(x) == pos(q) ? q : x);
+            }
+            rotate(x);
+        }
+        pull(x);
+    }
+
+    void access(int x) {
+        for (int i = x, q = 0; i; q = i, i = t[i].p) {
+            splay(i);
+            t[i].ch[1] = q;
+            pull(i);
+        }
+        splay(x);
+    }
+
+    void makeroot(int x) {
+        access(x);
+        reverse(x);
+    }
+
+    // makeroot(x) 后 access(y)，y 为所在 splay 的根：
+    // 若连通，x 在这棵 splay 中且不是根，t[x].p 非 0；
+    // 若不连通，x 仍是自己那棵树的 splay 根，且没有虚父亲，t[x].p 为 0
+    bool split(int x, int y) {
+        makeroot(x);
+        access(y);
+        return x == y || t[x].p != 0;
+    }
+
+    bool connected(int x, int y) { return split(x + 1, y + 1); }
+
+    // x、y 已连通时返回 false
+    bool link(int x, int y) {
+        x++, y++;
+        if (split(x, y)) {
+            return false;
+        }
+        t[x].p = y;
+        return true;
+    }
+
+    // 边 (x, y) 不存在时返回 false
+    bool cut(int x, int y) {
+        x++, y++;
+        if (!split(x, y) || t[y].ch[0] != x) {
+            return false;
+        }
+        push(x);
+        if (t[x].ch[1]) {
+            return false;
+        }
+        t[y].ch[0] = t[x].p = 0;
+        pull(y);
+        return true;
+    }
+
+    // 要求 x、y 连通
+    Info pathQuery(int x, int y) {
+        split(x + 1, y + 1);
+        return t[y + 1].sum;
+    }
+
+    void pathApply(int x, int y, const Tag& v) {
+        split(x + 1, y + 1);
+        apply(y + 1, v);
+    }
+
+    void modify(int x, const Info& v) {
+        x++;
+        access(x);
+        t[x].val = v;
+        pull(x);
+    }
+};
+
+// 示例：路径加、路径和（len 用于区间加）
+struct Tag {
+    long long add = 0;
+
+    void apply(const Tag& t) { add += t.add; }
+};
+
+struct Info {
+    long long sum = 0;
+    int len = 0;
+
+    void apply(const Tag& t) { sum += t.add * len; }
+    void reverse() {}
+};
+
+Info operator+(const Info& a, const Info& b) {
+    return {a.sum + b.sum, a.len + b.len};
+}
+
+// 基准测试：10^6 次随机 link/cut/路径查询/单点修改，与指针版本对比
+void benchmark(int n = 1000000, int q = 1000000) {
+    auto run = [&](auto&& link, auto&& cut, auto&& connected, auto&& query,
+                   auto&& modify) {
+        mt19937 rng(20251017);
+        vector<pair<int, int>> edges;
+        long long chk = 0;
+        for (int i = 0; i < q; i++) {
+            int op = rng() % 4, x = rng() % n, y = rng() % n;
+            if (op == 0) {
+                if (x != y && !connected(x, y)) {
+                    link(x, y);
+                    edges.push_back({x, y});
+                }
+            } else if (op == 1) {
+                if (!edges.empty()) {
+                    int k = rng() % edges.size();
+                    cut(edges[k].first, edges[k].second);
+                    swap(edges[k], edges.back());
+                    edges.pop_back();
+                }
+            } else if (op == 2) {
+                if (connected(x, y)) {
+                    chk = chk * 31 + query(x, y);
+                }
+            } else {
+                modify(x, (int)(rng() % 1000));
+            }
+        }
+        return chk;
+    };
+
+    auto timeit = [&](auto&& fn) {
+        auto st = chrono::steady_clock::now();
+        long long res = fn();
+        double t =
+            chrono::duration<double>(chrono::steady_clock::now() - st).count();
+        return pair(t, res);
+    };
+
+    auto [t1, r1] = timeit([&] {
+        vector<Node*> t(n);
+        for (auto& p : t) {
+            p = new Node();
+        }
+        return run([&](int x, int y) { link(t[x], t[y]); },
+                   [&](int x, int y) { cut(t[x], t[y]); },
+                   [&](int x, int y) { return connected(t[x], t[y]); },
+                   [&](int x, int y) {
+                       split(t[x], t[y]);
+                       return (long long)t[y]->sum;
+                   },
+                   [&](int x, int v) {
+                       access(t[x]);
+                       t[x]->val = v;
+                       pull(t[x]);
+                   });
+    });
+
+    auto [t2, r2] = timeit([&] {
+        LinkCutTree<Info, Tag> lct(n, Info{0, 1});
+        return run([&](int x, int y) { lct.link(x, y); },
+                   [&](int x, int y) { lct.cut(x, y); },
+                   [&](int x, int y) { return lct.connected(x, y); },
+                   [&](int x, int y) { return lct.pathQuery(x, y).sum; },
+                   [&](int x, int v) { lct.modify(x, Info{v, 1}); });
+    });
+
+    assert(r1 == r2);
+    cout << "pointer LCT: " << t1 << "s, array LCT: " << t2 << "s\n";
+}
+
+int main() {
+    benchmark();
+    return 0;
+}
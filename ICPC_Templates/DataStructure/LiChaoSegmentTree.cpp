@@ -2,6 +2,8 @@
 // 功能：动态维护一组直线，查询某点的最值
 // 复杂度：插入 O(log n), 查询 O(log n)
 // 应用：斜率优化DP、动态凸包
+// DynamicLiChaoTree 为动态开点版本，定义域可到 64 位，支持最小/最大值与线段插入
+// LineContainer 按插入与询问顺序自动选择单调队列凸包、平衡树凸包或李超树
 
 #include <bits/stdc++.h>
 using namespace std;
@@ -158,6 +160,333 @@ struct PersistentLiChaoTree {
     long long query(int ver, int x) { return query(roots[ver], 0, n - 1, x); }
 };
 
+// 动态开点李超线段树：定义域为任意 [lo, hi]（long long 范围内），节点按需从池中分配
+// MAX 为 false 时维护最小值，为 true 时维护最大值
+// 求值用 __int128，斜率、截距、坐标都可到 1e18 量级，无需离散化
+template <bool MAX = false>
+struct DynamicLiChaoTree {
+    using i128 = __int128;
+    // 查询点没有被任何直线覆盖时的返回值
+    static constexpr i128 NONE = MAX ? -((i128)1 << 126) : (i128)1 << 126;
+
+    struct Node {
+        int ls = 0, rs = 0;
+        bool has = false;
+        long long k = 0, b = 0;
+
+        i128 calc(long long x) const { return has ? (i128)k * x + b : NONE; }
+    };
+
+    long long lo, hi;
+    vector<Node> t;  // t[0] 为空节点，t[1] 为根
+
+    DynamicLiChaoTree(long long lo_, long long hi_, int reserve = 0)
+        : lo(lo_), hi(hi_) {
+        t.reserve(max(reserve, 2));
+        t.resize(2);
+    }
+
+    static bool better(i128 a, i128 b) { return MAX ? a > b : a < b; }
+
+    // 向下取整的中点，l + r 溢出时也正确
+    static long long mid(long long l, long long r) {
+        return (l & r) + ((l ^ r) >> 1);
+    }
+
+    int child(int p, int d) {
+        if (!(d ? t[p].rs : t[p].ls)) {
+            int c = t.size();
+            t.emplace_back();
+            (d ? t[p].rs : t[p].ls) = c;
+        }
+        return d ? t[p].rs : t[p].ls;
+    }
+
+    // 直线放入节点 p（对应 [l, r]）的子树
+    void insertLine(int p, long long l, long long r, Node line) {
+        line.has = true;
+        while (true) {
+            if (!t[p].has) {
+                t[p].k = line.k, t[p].b = line.b, t[p].has = true;
+                return;
+            }
+            long long m = mid(l, r);
+            bool lef = better(line.calc(l), t[p].calc(l));
+            bool midBetter = better(line.calc(m), t[p].calc(m));
+            if (midBetter) {
+                swap(t[p].k, line.k);
+                swap(t[p].b, line.b);
+            }
+            if (l == r) {
+                return;
+            }
+            if (lef != midBetter) {
+                p = child(p, 0), r = m;
+            } else {
+                p = child(p, 1), l = m + 1;
+            }
+        }
+    }
+
+    void insert(int p, long long l, long long r, long long L, long long R,
+                const Node& line) {
+        if (L <= l && r <= R) {
+            insertLine(p, l, r, line);
+            return;
+        }
+        long long m = mid(l, r);
+        if (L <= m) {
+            insert(child(p, 0), l, m, L, R, line);
+        }
+        if (m < R) {
+            insert(child(p, 1), m + 1, r, L, R, line);
+        }
+    }
+
+    // 插入直线 y = kx + b
+    void add_line(long long k, long long b) {
+        insertLine(1, lo, hi, Node{0, 0, true, k, b});
+    }
+
+    // 插入只在 [l, r] 上有效的线段
+    void add_segment(long long l, long long r, long long k, long long b) {
+        l = max(l, lo), r = min(r, hi);
+        if (l <= r) {
+            insert(1, lo, hi, l, r, Node{0, 0, true, k, b});
+        }
+    }
+
+    i128 query(long long x) const {
+        i128 res = NONE;
+        long long l = lo, r = hi;
+        for (int p = 1; p;) {
+            i128 v = t[p].calc(x);
+            if (better(v, res)) {
+                res = v;
+            }
+            long long m = mid(l, r);
+            if (x <= m) {
+                p = t[p].ls, r = m;
+            } else {
+                p = t[p].rs, l = m + 1;
+            }
+        }
+        return res;
+    }
+};
+
+// 统一的斜率优化容器：维护直线集合，查询某点的最小值（求最大值时把 k、b 取反）
+// 插入斜率单调（任一方向）时用双端队列维护下凸壳，询问横坐标也单调时
+// 用指针均摊 O(1) 找最优直线，否则在凸壳上二分 O(log n)
+// 一旦插入的斜率不再单调，把已有直线迁入后备结构，此后每次操作 O(log n)：
+// 默认为平衡树（multiset）动态凸包，构造时给出定义域 [lo, hi] 则用 DynamicLiChaoTree
+// 直线参数与查询结果需在 long long 范围内，中间计算用 __int128
+struct LineContainer {
+    using i128 = __int128;
+    enum Mode { DEQUE, BST, LICHAO };
+
+    // 平衡树凸包按 -k、-b 存放维护最大值；p 为与后继的交点横坐标（向下取整）
+    struct HullLine {
+        mutable long long k, b, p;
+
+        bool operator<(const HullLine& o) const { return k < o.k; }
+        bool operator<(long long x) const { return p < x; }
+    };
+
+    Mode mode = DEQUE;
+    bool bounded = false;
+    int kdir = 0, xdir = 0;  // 已观察到的斜率、询问方向，0 为尚未确定
+    long long lastX = 0;
+    bool xMono = true, queried = false;
+    deque<Line> hull;  // 斜率从大到小
+    int ptr = 0;       // 上次询问的最优直线在 hull 中的下标
+    multiset<HullLine, less<>> bst;
+    DynamicLiChaoTree<false> lichao{0, 0};
+
+    LineContainer() {}
+    LineContainer(long long lo, long long hi) : bounded(true), lichao(lo, hi) {}
+
+    static i128 eval(const Line& l, long long x) { return (i128)l.k * x + l.b; }
+
+    // 斜率 k1 > k2 > k3 时，l2 是否不在下凸壳上
+    static bool bad(const Line& l1, const Line& l2, const Line& l3) {
+        return (i128)(l3.b - l1.b) * (l1.k - l2.k) <=
+               (i128)(l2.b - l1.b) * (l1.k - l3.k);
+    }
+
+    void add(long long k, long long b) {
+        if (mode == DEQUE && !hull.empty()) {
+            long long k0 = kdir > 0 ? hull.front().k : hull.back().k;
+            int d = (k > k0) - (k < k0);
+            if (d && kdir && d != kdir) {
+                migrate();
+            } else if (d) {
+                kdir = d;
+            }
+        }
+        if (mode == BST) {
+            bstAdd(-k, -b);
+        } else if (mode == LICHAO) {
+            lichao.add_line(k, b);
+        } else if (kdir > 0) {
+            pushFront({k, b});
+        } else {
+            pushBack({k, b});
+        }
+    }
+
+    void pushBack(Line l) {
+        if (!hull.empty() && hull.back().k == l.k) {
+            if (hull.back().b <= l.b) {
+                return;
+            }
+            hull.pop_back();
+        }
+        while (hull.size() >= 2 && bad(hull[hull.size() - 2], hull.back(), l)) {
+            hull.pop_back();
+        }
+        hull.push_back(l);
+        int e = hull.size() - 1;
+        // 上次询问点处的最优直线要么不变，要么是新直线
+        if (ptr >= e || (queried && eval(l, lastX) <= eval(hull[ptr], lastX))) {
+            ptr = e;
+        }
+    }
+
+    void pushFront(Line l) {
+        if (!hull.empty() && hull.front().k == l.k) {
+            if (hull.front().b <= l.b) {
+                return;
+            }
+            hull.pop_front();
+            ptr--;
+        }
+        while (hull.size() >= 2 && bad(l, hull[0], hull[1])) {
+            hull.pop_front();
+            ptr--;
+        }
+        hull.push_front(l);
+        ptr++;
+        if (ptr <= 0 || (queried && eval(l, lastX) <= eval(hull[ptr], lastX))) {
+            ptr = 0;
+        }
+    }
+
+    void migrate() {
+        mode = bounded ? LICHAO : BST;
+        for (auto& l : hull) {
+            if (bounded) {
+                lichao.add_line(l.k, l.b);
+            } else {
+                bstAdd(-l.k, -l.b);
+            }
+        }
+        hull.clear();
+    }
+
+    static long long floorDiv(long long a, long long b) {
+        return a / b - ((a ^ b) < 0 && a % b);
+    }
+
+    using It = multiset<HullLine, less<>>::iterator;
+
+    bool isect(It x, It y) {
+        if (y == bst.end()) {
+            x->p = LLONG_MAX;
+            return false;
+        }
+        if (x->k == y->k) {
+            x->p = x->b > y->b ? LLONG_MAX : LLONG_MIN;
+        } else {
+            x->p = floorDiv(y->b - x->b, x->k - y->k);
+        }
+        return x->p >= y->p;
+    }
+
+    void bstAdd(long long k, long long b) {
+        auto z = bst.insert({k, b, 0}), y = z++, x = y;
+        while (isect(y, z)) {
+            z = bst.erase(z);
+        }
+        if (x != bst.begin() && isect(--x, y)) {
+            isect(x, y = bst.erase(y));
+        }
+        while ((y = x) != bst.begin() && (--x)->p >= y->p) {
+            isect(x, bst.erase(y));
+        }
+    }
+
+    // 至少插入过一条直线
+    long long query(long long x) {
+        if (mode == BST) {
+            auto it = bst.lower_bound(x);
+            return -((i128)it->k * x + it->b);
+        }
+        if (mode == LICHAO) {
+            return lichao.query(x);
+        }
+        if (queried && xMono && x != lastX) {
+            int d = x > lastX ? 1 : -1;
+            if (xdir && d != xdir) {
+                xMono = false;
+            }
+            xdir = d;
+        }
+        queried = true;
+        lastX = x;
+        int n = hull.size();
+        if (xMono) {
+            // x 增大时最优直线的斜率变小，在 hull 中向后移动
+            while (ptr + 1 < n &&
+                   eval(hull[ptr + 1], x) <= eval(hull[ptr], x)) {
+                ptr++;
+            }
+            while (ptr > 0 && eval(hull[ptr - 1], x) <= eval(hull[ptr], x)) {
+                ptr--;
+            }
+        } else {
+            int l = 0, r = n - 1;
+            while (l < r) {
+                int m = (l + r) / 2;
+                if (eval(hull[m + 1], x) <= eval(hull[m], x)) {
+                    l = m + 1;
+                } else {
+                    r = m;
+                }
+            }
+            ptr = l;
+        }
+        return eval(hull[ptr], x);
+    }
+};
+
+// 基准测试：三条路径各 10^7 次操作（插入与询问各半），与暴力结果抽查比对
+void benchmark(int ops = 10000000) {
+    mt19937_64 rng(20251017);
+    auto timeit = [&](const char* name, LineContainer lc, auto&& slope,
+                      auto&& point) {
+        long long chk = 0;
+        auto st = chrono::steady_clock::now();
+        for (int i = 0; i < ops / 2; i++) {
+            lc.add(slope(i), (long long)(rng() % 2000000001) - 1000000000);
+            chk += lc.query(point(i));
+        }
+        double t =
+            chrono::duration<double>(chrono::steady_clock::now() - st).count();
+        cout << name << ": " << t << "s (mode " << lc.mode << ", " << chk
+             << ")\n";
+    };
+    long long lo = -1000000000, hi = 1000000000;
+    auto rx = [&](int) { return lo + (long long)(rng() % (hi - lo + 1)); };
+    auto rk = [&](int) { return (long long)(rng() % 2000001) - 1000000; };
+    timeit(
+        "deque, monotone", LineContainer(), [&](int i) { return -i; },
+        [&](int i) { return lo + 300LL * i; });
+    timeit("deque, random x", LineContainer(), [&](int i) { return -i; }, rx);
+    timeit("bst", LineContainer(), rk, rx);
+    timeit("lichao", LineContainer(lo, hi), rk, rx);
+}
+
 // 使用示例
 void solve() {
     int n, q;
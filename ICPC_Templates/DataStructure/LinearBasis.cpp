@@ -2,6 +2,8 @@
  * 线性基 (Linear Basis)
  * 功能：维护异或空间的一组基
  * 应用：最大异或和，异或第k小等
+ * Basis 为 20 位带时间戳版本；WideBasis<W> 支持 32/64 位整数和 bitset<W>，
+ * PrefixBasis<W> 预处理 O(n·W)，回答区间 a[l, r) 最大异或和 O(W)
  */
 #include <bits/stdc++.h>
 using namespace std;
@@ -13,7 +15,7 @@ struct Basis {
     Basis() { fill(t, t + 20, -1); }
 
     void add(int x, int y = 1e9) {
-        for (int i = 0; i < 20; i++) {
+        for (int i = 19; i >= 0; i--) {
             if (x >> i & 1) {
                 if (y > t[i]) {
                     swap(a[i], x);
@@ -25,7 +27,7 @@ struct Basis {
     }
 
     bool query(int x, int y = 0) {
-        for (int i = 0; i < 20; i++) {
+        for (int i = 19; i >= 0; i--) {
             if ((x >> i & 1) && t[i] >= y) {
                 x ^= a[i];
             }
@@ -41,3 +43,126 @@ struct Basis {
         return res;
     }
 };
+
+// W <= 32 用 uint32_t，W <= 64 用 uint64_t，否则用 bitset<W>
+template <int W>
+using BasisWord =
+    conditional_t<W <= 32, uint32_t,
+                  conditional_t<W <= 64, uint64_t, bitset<W>>>;
+
+template <int W, class T = BasisWord<W>>
+struct WideBasis {
+    T a[W]{};
+    int t[W];
+
+    WideBasis() { fill(t, t + W, -1); }
+
+    static bool bit(const T& x, int i) {
+        if constexpr (is_integral_v<T>) {
+            return x >> i & 1;
+        } else {
+            return x[i];
+        }
+    }
+
+    // 同 Basis::add：同一主元位保留时间戳更大的向量
+    void add(T x, int y = INT_MAX) {
+        for (int i = W - 1; i >= 0; i--) {
+            if (bit(x, i)) {
+                if (y > t[i]) {
+                    swap(a[i], x);
+                    swap(t[i], y);
+                }
+                x ^= a[i];
+            }
+        }
+    }
+
+    // x 能否由时间戳 >= y 的向量异或得到
+    bool query(T x, int y = 0) const {
+        for (int i = W - 1; i >= 0; i--) {
+            if (bit(x, i) && t[i] >= y) {
+                x ^= a[i];
+            }
+        }
+        return x == T();
+    }
+
+    // 只用时间戳 >= y 的向量能得到的最大异或和
+    T queryMax(int y = 0) const {
+        T res{};
+        for (int i = W - 1; i >= 0; i--) {
+            if (t[i] >= y && !bit(res, i)) {
+                res ^= a[i];
+            }
+        }
+        return res;
+    }
+};
+
+// 前缀线性基：pre[r] 为插入 a[0, r) 后的基，时间戳为下标
+template <int W, class T = BasisWord<W>>
+struct PrefixBasis {
+    vector<WideBasis<W, T>> pre;
+
+    PrefixBasis(const vector<T>& a) {
+        int n = a.size();
+        pre.resize(n + 1);
+        for (int i = 0; i < n; i++) {
+            pre[i + 1] = pre[i];
+            pre[i + 1].add(a[i], i);
+        }
+    }
+
+    T queryMax(int l, int r) const { return pre[r].queryMax(l); }  // [l, r)
+};
+
+// 使用示例
+void example() {
+    vector<uint64_t> a = {1ULL << 60, 3, 5, (1ULL << 60) | 6};
+    PrefixBasis<64> pb(a);
+    cout << pb.queryMax(1, 3) << "\n";  // 3 ^ 5 = 6
+    cout << pb.queryMax(0, 4) << "\n";  // 2^60 + 6
+
+    WideBasis<256> wb;
+    bitset<256> x;
+    x[200] = x[3] = 1;
+    wb.add(x);
+    cout << wb.query(x) << "\n";  // 1
+
+    Basis b;
+    b.add(3);
+    b.add(1);
+    cout << b.query(3 ^ 1) << "\n";  // 1
+    cout << b.query(4) << "\n";      // 0
+}
+
+// 基准测试：10^6 次 64 位区间最大异或和
+void benchmark(int n = 1000000, int q = 1000000) {
+    mt19937_64 rng(20251017);
+    vector<uint64_t> a(n);
+    for (auto& x : a) {
+        x = rng();
+    }
+    auto st = chrono::steady_clock::now();
+    PrefixBasis<64> pb(a);
+    auto mid = chrono::steady_clock::now();
+    uint64_t chk = 0;
+    for (int i = 0; i < q; i++) {
+        int l = rng() % n, r = rng() % n;
+        if (l > r) {
+            swap(l, r);
+        }
+        chk ^= pb.queryMax(l, r + 1);
+    }
+    auto ed = chrono::steady_clock::now();
+    cout << "build: " << chrono::duration<double>(mid - st).count()
+         << "s, query: " << chrono::duration<double>(ed - mid).count()
+         << "s, checksum = " << chk << "\n";
+}
+
+int main() {
+    example();
+    benchmark();
+    return 0;
+}
@@ -0,0 +1,153 @@
+/**
+ * 线性空间 RMQ (Linear RMQ)
+ * 功能：静态区间最值及其位置（并列取最左），支持任意比较器
+ * 复杂度：预处理 O(n)，查询 O(1)
+ * 原理：每 32 个元素分一块，块内用单调栈的位掩码回答，块间对块最值建 ST 表
+ * 空间：原数组 + 每元素一个 uint32 掩码 + (n/32)·log 个 int，约为 SparseTable 的 1/10
+ */
+#include <bits/stdc++.h>
+using namespace std;
+
+template <typename T, class Cmp = less<T>>
+struct LinearRMQ {
+    static constexpr int B = 32;
+    int n;
+    vector<T> a;
+    Cmp cmp;
+    vector<uint32_t> mask;  // mask[i]：块内以 i 结尾的单调栈，第 j 位对应块内第 j 个元素
+    vector<vector<int>> st;  // 块间 ST 表，存位置
+
+    LinearRMQ() : n(0) {}
+    LinearRMQ(const vector<T>& a_, Cmp cmp_ = Cmp()) : a(a_), cmp(cmp_) {
+        n = a.size();
+        mask.assign(n, 0);
+        int m = (n + B - 1) / B;
+        for (int b = 0; b < m; b++) {
+            int s = b * B, e = min(n, s + B);
+            uint32_t cur = 0;
+            for (int i = s; i < e; i++) {
+                // 弹出严格劣于 a[i] 的元素，相等的保留以取最左
+                while (cur && cmp(a[i], a[s + 31 - __builtin_clz(cur)])) {
+                    cur ^= 1u << (31 - __builtin_clz(cur));
+                }
+                cur |= 1u << (i - s);
+                mask[i] = cur;
+            }
+        }
+        int lg = m ? __lg(m) + 1 : 1;
+        st.assign(lg, vector<int>(m));
+        for (int b = 0; b < m; b++) {
+            st[0][b] = b * B + __builtin_ctz(mask[min(n, b * B + B) - 1]);
+        }
+        for (int i = 1; i < lg; i++) {
+            for (int j = 0; j + (1 << i) <= m; j++) {
+                st[i][j] = best(st[i - 1][j], st[i - 1][j + (1 << (i - 1))]);
+            }
+        }
+    }
+
+    int best(int i, int j) const { return cmp(a[j], a[i]) ? j : i; }
+
+    // 块内 [l, r]，要求同一块
+    int inBlock(int l, int r) const {
+        int s = l / B * B;
+        return l + __builtin_ctz(mask[r] >> (l - s));
+    }
+
+    int argmin(int l, int r) const {  // [l, r)
+        r--;
+        int bl = l / B, br = r / B;
+        if (bl == br) {
+            return inBlock(l, r);
+        }
+        int res = inBlock(l, bl * B + B - 1);
+        if (bl + 1 < br) {
+            int k = __lg(br - bl - 1);
+            res = best(res, best(st[k][bl + 1], st[k][br - (1 << k)]));
+        }
+        return best(res, inBlock(br * B, r));
+    }
+
+    T query(int l, int r) const { return a[argmin(l, r)]; }  // [l, r)
+
+    size_t memory() const {
+        size_t res = a.size() * sizeof(T) + mask.size() * sizeof(uint32_t);
+        for (auto& v : st) {
+            res += v.size() * sizeof(int);
+        }
+        return res;
+    }
+};
+
+// 使用示例
+void example() {
+    vector<int> a = {3, 1, 4, 1, 5, 9, 2, 6};
+    LinearRMQ<int> mn(a);
+    LinearRMQ<int, greater<int>> mx(a);
+
+    cout << mn.query(0, 8) << " " << mn.argmin(0, 8) << "\n";  // 1 1
+    cout << mn.argmin(2, 8) << "\n";                           // 3
+    cout << mx.query(2, 5) << " " << mx.argmin(2, 5) << "\n";  // 5 4
+}
+
+// 基准测试：与 SparseTable 比较内存和查询耗时
+#include "SparseTable.cpp"
+
+void benchmark(int n = 20000000, int q = 20000000) {
+    mt19937 rng(20251017);
+    vector<int> a(n);
+    for (auto& x : a) {
+        x = rng();
+    }
+    vector<pair<int, int>> qs(q);
+    for (auto& [l, r] : qs) {
+        l = rng() % n;
+        r = rng() % n;
+        if (l > r) {
+            swap(l, r);
+        }
+        r++;
+    }
+
+    auto timeit = [&](auto&& fn) {
+        auto st = chrono::steady_clock::now();
+        long long res = fn();
+        double t =
+            chrono::duration<double>(chrono::steady_clock::now() - st).count();
+        return pair(t, res);
+    };
+
+    long long mem1 = 0;
+    auto [t1, r1] = timeit([&] {
+        SparseTable<int> st(a);
+        for (auto& v : st.st) {
+            mem1 += v.size() * sizeof(int);
+        }
+        long long chk = 0;
+        for (auto [l, r] : qs) {
+            chk += st.query(l, r);
+        }
+        return chk;
+    });
+
+    size_t mem2 = 0;
+    auto [t2, r2] = timeit([&] {
+        LinearRMQ<int> rmq(a);
+        mem2 = rmq.memory();
+        long long chk = 0;
+        for (auto [l, r] : qs) {
+            chk += rmq.query(l, r);
+        }
+        return chk;
+    });
+
+    assert(r1 == r2);
+    cout << "SparseTable: " << mem1 / 1048576 << "MB, " << t1 << "s\n";
+    cout << "LinearRMQ  : " << mem2 / 1048576 << "MB, " << t2 << "s\n";
+}
+
+int main() {
+    example();
+    benchmark();
+    return 0;
+}
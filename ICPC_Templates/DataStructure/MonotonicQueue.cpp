@@ -2,6 +2,8 @@
  * 单调队列 (Monotonic Queue)
  * 功能：维护滑动窗口最值
  * 复杂度：O(n)
+ * SlidingWindow 为流式版本（定长环形缓冲区，无动态分配），
+ * slidingWindowBlock 为 van Herk/Gil-Werman 分块版本，每个元素的代价与 k 无关
  */
 #include <bits/stdc++.h>
 using namespace std;
@@ -54,6 +56,89 @@ vector<T> slidingWindowMax(const vector<T>& a, int k) {
     return res;
 }
 
+// 流式滑动窗口最值：窗口为最近 k 个元素，Cmp 为 less 时求最小值
+template <typename T, class Cmp = less<T>>
+struct SlidingWindow {
+    int k;
+    unsigned mask;
+    vector<T> val;
+    vector<long long> idx;
+    unsigned head = 0, tail = 0;  // 单调队列在环形缓冲区中的 [head, tail)
+    long long lo = 0, hi = 0;     // 窗口内元素的编号为 [lo, hi)
+    Cmp cmp;
+
+    SlidingWindow(int k_, Cmp cmp_ = Cmp()) : k(k_), cmp(cmp_) {
+        int cap = 1;
+        while (cap < k + 1) {
+            cap *= 2;
+        }
+        mask = cap - 1;
+        val.resize(cap);
+        idx.resize(cap);
+    }
+
+    int size() const { return hi - lo; }
+
+    // 加入新元素，窗口超过 k 时自动弹出最旧的元素
+    void push(const T& x) {
+        while (head != tail && !cmp(val[(tail - 1) & mask], x)) {
+            tail--;
+        }
+        val[tail & mask] = x;
+        idx[tail & mask] = hi++;
+        tail++;
+        if (hi - lo > k) {
+            pop();
+        }
+    }
+
+    // 弹出窗口中最旧的元素，要求窗口非空
+    void pop() {
+        assert(lo < hi);
+        if (idx[head & mask] == lo) {
+            head++;
+        }
+        lo++;
+    }
+
+    // 当前窗口的最值，要求窗口非空
+    const T& get() const {
+        assert(lo < hi);
+        return val[head & mask];
+    }
+};
+
+// van Herk/Gil-Werman：按 k 分块，块内后缀最值 suf 与前缀最值取 min
+// out 长度为 n - k + 1，suf 为长度 n 的临时数组，均由调用者提供
+template <typename T, class Cmp = less<T>>
+void slidingWindowBlock(const T* a, int n, int k, T* out, T* suf,
+                        Cmp cmp = Cmp()) {
+    if (n < k) {
+        return;
+    }
+    for (int s = 0; s < n; s += k) {
+        int e = min(n, s + k);
+        suf[e - 1] = a[e - 1];
+        for (int i = e - 2; i >= s; i--) {
+            suf[i] = cmp(a[i], suf[i + 1]) ? a[i] : suf[i + 1];
+        }
+    }
+    // 块内前缀最值直接写到 out[j - k + 1]
+    for (int s = 0; s < n; s += k) {
+        int e = min(n, s + k);
+        T cur = a[s];
+        for (int j = s; j < e; j++) {
+            cur = cmp(a[j], cur) ? a[j] : cur;
+            if (j >= k - 1) {
+                out[j - k + 1] = cur;
+            }
+        }
+    }
+    for (int i = 0; i + k <= n; i++) {
+        out[i] = cmp(suf[i], out[i]) ? suf[i] : out[i];
+    }
+}
+
 // 单调栈求每个元素左边第一个比它小的元素
 template <typename T>
 vector<int> prevSmaller(const vector<T>& a) {
@@ -91,3 +176,51 @@ vector<int> nextSmaller(const vector<T>& a) {
     }
     return res;
 }
+
+// 基准测试：deque 版本、流式版本、分块版本对比
+void benchmark(int n = 50000000) {
+    mt19937 rng(20251017);
+    vector<int> a(n);
+    for (auto& x : a) {
+        x = rng();
+    }
+    vector<int> out(n), suf(n);
+
+    auto timeit = [&](auto&& fn) {
+        auto st = chrono::steady_clock::now();
+        long long res = fn();
+        double t =
+            chrono::duration<double>(chrono::steady_clock::now() - st).count();
+        return pair(t, res);
+    };
+
+    for (int k : {4, 64, 4096, 1 << 20}) {
+        auto [t1, r1] = timeit([&] {
+            auto res = slidingWindowMin(a, k);
+            return accumulate(res.begin(), res.end(), 0LL);
+        });
+        auto [t2, r2] = timeit([&] {
+            SlidingWindow<int> w(k);
+            long long sum = 0;
+            for (int i = 0; i < n; i++) {
+                w.push(a[i]);
+                if (i >= k - 1) {
+                    sum += w.get();
+                }
+            }
+            return sum;
+        });
+        auto [t3, r3] = timeit([&] {
+            slidingWindowBlock(a.data(), n, k, out.data(), suf.data());
+            return accumulate(out.begin(), out.begin() + n - k + 1, 0LL);
+        });
+        assert(r1 == r2 && r1 == r3);
+        cout << "k = " << k << ": deque " << t1 << "s, stream " << t2
+             << "s, block " << t3 << "s\n";
+    }
+}
+
+int main() {
+    benchmark();
+    return 0;
+}
@@ -2,10 +2,137 @@
  * 可持久化线段树 (Persistent Segment Tree / Chairman Tree)
  * 功能：维护历史版本，区间k小值等
  * 复杂度：O(log n) 单次操作
+ * 指针版本每个节点单独 new；PersistentSegTree 为节点池版本，32 位下标、一次性预留，
+ * 支持淘汰旧版本后压缩回收；save() 写出节点池，MappedPersistentSegTree 用 mmap 只读加载
  */
 #include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 using namespace std;
 
+// ---- 可选：快照持久化。不需要时可连同 save() 与 Mapped* 一起删去 ----
+// 与 PersistentTrie.cpp / PersistentSegTree.cpp 中的同一段相同，用宏防止重复定义
+#ifndef SNAPSHOT_HELPERS
+#define SNAPSHOT_HELPERS
+// 只读内存映射文件，多个进程映射同一文件时共享物理页
+struct MappedFile {
+    const char* data = nullptr;
+    size_t len = 0;
+
+    MappedFile() {}
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() {
+        if (data) {
+            munmap((void*)data, len);
+        }
+    }
+
+    bool open(const string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) < 0 || st.st_size == 0) {
+            close(fd);
+            return false;
+        }
+        len = st.st_size;
+        void* p = mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (p == MAP_FAILED) {
+            return false;
+        }
+        data = (const char*)p;
+        return true;
+    }
+};
+
+// 文件格式：文件头，随后是 nodeCount 个节点、rootCount 个版本根，
+// 再是 aliveCount 个版本存活标记（为 0 表示全部存活，否则等于 rootCount）
+struct SnapshotHeader {
+    char magic[8];
+    long long param;  // 与结构相关的参数（位数或值域大小）
+    long long nodeCount, rootCount, aliveCount;
+};
+
+template <class Node>
+bool writeSnapshot(const string& path, const char* magic, long long param,
+                   const vector<Node>& nodes, const vector<int>& roots,
+                   const vector<char>& alive = {}) {
+    static_assert(is_trivially_copyable_v<Node>);
+    FILE* fp = fopen(path.c_str(), "wb");
+    if (!fp) {
+        return false;
+    }
+    SnapshotHeader h{};
+    memcpy(h.magic, magic, 8);
+    h.param = param;
+    h.nodeCount = nodes.size();
+    h.rootCount = roots.size();
+    h.aliveCount = alive.size();
+    bool ok = fwrite(&h, sizeof(h), 1, fp) == 1 &&
+              fwrite(nodes.data(), sizeof(Node), nodes.size(), fp) ==
+                  nodes.size() &&
+              fwrite(roots.data(), sizeof(int), roots.size(), fp) ==
+                  roots.size() &&
+              fwrite(alive.data(), 1, alive.size(), fp) == alive.size();
+    return fclose(fp) == 0 && ok;
+}
+
+// 校验文件头与长度，成功时给出节点、版本根与存活标记的指针（无标记时为 nullptr）
+// 及节点数、版本数；各计数来自文件，先逐个与剩余长度比较再相乘，避免溢出
+// 节点内的下标由调用者用 checkSnapshotIndex 校验
+template <class Node>
+bool readSnapshot(const MappedFile& f, const char* magic, long long& param,
+                  const Node*& nodes, const int*& roots, const char*& alive,
+                  long long& nodeCount, long long& rootCount) {
+    if (f.len < sizeof(SnapshotHeader)) {
+        return false;
+    }
+    SnapshotHeader h;
+    memcpy(&h, f.data, sizeof(h));
+    if (memcmp(h.magic, magic, 8) != 0 || h.nodeCount < 0 ||
+        h.rootCount < 0 || h.aliveCount < 0) {
+        return false;
+    }
+    size_t rest = f.len - sizeof(h);
+    if ((unsigned long long)h.nodeCount > rest / sizeof(Node)) {
+        return false;
+    }
+    rest -= h.nodeCount * sizeof(Node);
+    if ((unsigned long long)h.rootCount > rest / sizeof(int)) {
+        return false;
+    }
+    rest -= h.rootCount * sizeof(int);
+    if ((unsigned long long)h.aliveCount != rest ||
+        (h.aliveCount != 0 && h.aliveCount != h.rootCount)) {
+        return false;
+    }
+    param = h.param;
+    nodes = (const Node*)(f.data + sizeof(h));
+    roots = (const int*)(f.data + sizeof(h) + h.nodeCount * sizeof(Node));
+    alive = h.aliveCount ? (const char*)(roots + h.rootCount) : nullptr;
+    nodeCount = h.nodeCount;
+    rootCount = h.rootCount;
+    return true;
+}
+
+// 所有版本根都须是 [0, nodeCount) 内的下标；损坏或版本不符的文件在打开时即失败
+inline bool checkSnapshotIndex(const int* a, long long cnt, long long nodeCount) {
+    for (long long i = 0; i < cnt; i++) {
+        if (a[i] < 0 || a[i] >= nodeCount) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif  // SNAPSHOT_HELPERS
+// ---- 快照持久化结束 ----
+
 struct Node {
     Node* l = nullptr;
     Node* r = nullptr;
@@ -68,3 +195,306 @@ pair<int, int> rangeQuery(Node* tl, Node* tr, int l, int r, int x, int y) {
     auto [cr, sr] = rangeQuery(tl->r, tr->r, m, r, x, y);
     return {cl + cr, sl + sr};
 }
+
+// 节点池版本：值域 [0, n)，版本 0 为空树，0 号节点为空节点（不需要 build）
+struct PersistentSegTree {
+    struct Node {
+        int l = 0, r = 0;
+        int cnt = 0;
+    };
+
+    int n;
+    vector<Node> pool;
+    vector<int> roots;
+    vector<char> alive;
+
+    // reserve 为预计节点数，通常取 修改次数 * (__lg(n) + 2)
+    PersistentSegTree(int n_, size_t reserve = 0) : n(n_) {
+        pool.reserve(reserve + 1);
+        pool.push_back(Node());
+        roots.push_back(0);
+        alive.push_back(1);
+    }
+
+    int clone(int x) {
+        pool.push_back(pool[x]);
+        return pool.size() - 1;
+    }
+
+    // 在版本 ver 的基础上令位置 p 的计数加 v，返回新版本号
+    int add(int ver, int p, int v) {
+        int old = roots[ver];
+        int root = clone(old), cur = root;
+        pool[cur].cnt += v;
+        int l = 0, r = n;
+        while (r - l > 1) {
+            int m = (l + r) / 2;
+            if (p < m) {
+                old = pool[old].l;
+                int c = clone(old);
+                pool[c].cnt += v;
+                pool[cur].l = c;
+                cur = c;
+                r = m;
+            } else {
+                old = pool[old].r;
+                int c = clone(old);
+                pool[c].cnt += v;
+                pool[cur].r = c;
+                cur = c;
+                l = m;
+            }
+        }
+        roots.push_back(root);
+        alive.push_back(1);
+        return roots.size() - 1;
+    }
+
+    // 版本 vr 减去版本 vl 后的第 k 小（k 从 1 开始）
+    int query(int vl, int vr, int k) const {
+        int x = roots[vl], y = roots[vr];
+        int l = 0, r = n;
+        while (r - l > 1) {
+            int m = (l + r) / 2;
+            int cnt = pool[pool[y].l].cnt - pool[pool[x].l].cnt;
+            if (k <= cnt) {
+                x = pool[x].l;
+                y = pool[y].l;
+                r = m;
+            } else {
+                k -= cnt;
+                x = pool[x].r;
+                y = pool[y].r;
+                l = m;
+            }
+        }
+        return l;
+    }
+
+    // 版本 vr 减去版本 vl 后，值域 [x, y) 内的计数
+    int rangeQuery(int vl, int vr, int x, int y) const {
+        return count(roots[vr], 0, n, x, y) - count(roots[vl], 0, n, x, y);
+    }
+
+    int count(int p, int l, int r, int x, int y) const {
+        if (!p || l >= y || r <= x) {
+            return 0;
+        }
+        if (l >= x && r <= y) {
+            return pool[p].cnt;
+        }
+        int m = (l + r) / 2;
+        return count(pool[p].l, l, m, x, y) + count(pool[p].r, m, r, x, y);
+    }
+
+    // 淘汰版本：之后不能再查询，compact() 时回收只属于它的节点
+    void retire(int ver) { alive[ver] = 0; }
+
+    // 只保留仍存活版本可达的节点，重新编号到新节点池中
+    void compact() {
+        vector<int> id(pool.size(), -1);
+        vector<Node> np;
+        np.push_back(Node());
+        id[0] = 0;
+        vector<int> stk;
+        for (int v = 0; v < (int)roots.size(); v++) {
+            if (!alive[v]) {
+                roots[v] = 0;
+                continue;
+            }
+            stk.push_back(roots[v]);
+            while (!stk.empty()) {
+                int x = stk.back();
+                if (id[x] != -1) {
+                    stk.pop_back();
+                    continue;
+                }
+                int a = pool[x].l, b = pool[x].r;
+                if (id[a] == -1) {
+                    stk.push_back(a);
+                } else if (id[b] == -1) {
+                    stk.push_back(b);
+                } else {
+                    stk.pop_back();
+                    id[x] = np.size();
+                    np.push_back({id[a], id[b], pool[x].cnt});
+                }
+            }
+            roots[v] = id[roots[v]];
+        }
+        pool.swap(np);
+        pool.shrink_to_fit();
+    }
+
+    size_t memory() const {
+        return pool.capacity() * sizeof(Node) + roots.capacity() * sizeof(int) +
+               alive.capacity();
+    }
+
+    // 存活标记一并写出，加载后版本号与淘汰状态不变；先 compact() 可缩小文件
+    bool save(const string& path) const {
+        return writeSnapshot(path, "PSEGTREE", n, pool, roots, alive);
+    }
+};
+
+// 从 save() 写出的文件只读加载，只校验下标、不重建，查询直接访问映射的页
+struct MappedPersistentSegTree {
+    using Node = PersistentSegTree::Node;
+
+    MappedFile file;
+    int n = 0;
+    const Node* pool = nullptr;
+    const int* roots = nullptr;
+    const char* aliveFlags = nullptr;
+    int versions = 0;
+
+    // 打开时检查所有版本根与儿子下标都在节点池内，O(节点数)
+    bool open(const string& path) {
+        long long param, nodeCount, rootCount;
+        if (!file.open(path) ||
+            !readSnapshot(file, "PSEGTREE", param, pool, roots, aliveFlags,
+                          nodeCount, rootCount) ||
+            param < 1 || param > INT_MAX || nodeCount < 1 ||
+            rootCount > INT_MAX ||
+            !checkSnapshotIndex(roots, rootCount, nodeCount)) {
+            return false;
+        }
+        for (long long i = 0; i < nodeCount; i++) {
+            const Node& x = pool[i];
+            if (x.l < 0 || x.l >= nodeCount || x.r < 0 || x.r >= nodeCount) {
+                return false;
+            }
+        }
+        n = param;
+        versions = rootCount;
+        return true;
+    }
+
+    // 保存时已淘汰的版本不能查询
+    bool alive(int ver) const { return !aliveFlags || aliveFlags[ver]; }
+
+    // 同 PersistentSegTree::query
+    int query(int vl, int vr, int k) const {
+        int x = roots[vl], y = roots[vr];
+        int l = 0, r = n;
+        while (r - l > 1) {
+            int m = (l + r) / 2;
+            int cnt = pool[pool[y].l].cnt - pool[pool[x].l].cnt;
+            if (k <= cnt) {
+                x = pool[x].l;
+                y = pool[y].l;
+                r = m;
+            } else {
+                k -= cnt;
+                x = pool[x].r;
+                y = pool[y].r;
+                l = m;
+            }
+        }
+        return l;
+    }
+
+    int rangeQuery(int vl, int vr, int x, int y) const {
+        return count(roots[vr], 0, n, x, y) - count(roots[vl], 0, n, x, y);
+    }
+
+    int count(int p, int l, int r, int x, int y) const {
+        if (!p || l >= y || r <= x) {
+            return 0;
+        }
+        if (l >= x && r <= y) {
+            return pool[p].cnt;
+        }
+        int m = (l + r) / 2;
+        return count(pool[p].l, l, m, x, y) + count(pool[p].r, m, r, x, y);
+    }
+};
+
+// 快照示例：建树、淘汰一个版本后 save()，再映射回来对比查询结果
+void segSnapshotExample(const string& path = "psegtree.snap") {
+    vector<int> a = {3, 1, 4, 1, 5, 9, 2, 6};
+    PersistentSegTree seg(10);
+    for (int x : a) {
+        seg.add(seg.roots.size() - 1, x, 1);
+    }
+    seg.retire(2);
+    if (!seg.save(path)) {
+        return;
+    }
+    MappedPersistentSegTree m;
+    if (m.open(path)) {
+        for (int l = 0; l < 8; l++) {
+            for (int r = l + 1; r <= 8; r++) {
+                assert(m.query(l, r, 1) == seg.query(l, r, 1));
+                assert(m.rangeQuery(l, r, 2, 6) == seg.rangeQuery(l, r, 2, 6));
+            }
+        }
+        cout << m.query(0, 8, 4) << " " << m.alive(2) << "\n";  // 3 0
+    }
+    remove(path.c_str());
+}
+
+// 基准测试：前缀版本建树 + 10^6 次区间第 k 小，与指针版本对比
+void benchmark(int n = 1000000, int q = 1000000) {
+    mt19937 rng(20251017);
+    vector<int> a(n);
+    for (auto& x : a) {
+        x = rng() % n;
+    }
+    vector<array<int, 3>> qs(q);
+    for (auto& [l, r, k] : qs) {
+        l = rng() % n;
+        r = rng() % n;
+        if (l > r) {
+            swap(l, r);
+        }
+        r++;
+        k = rng() % (r - l) + 1;
+    }
+
+    auto timeit = [&](auto&& fn) {
+        auto st = chrono::steady_clock::now();
+        long long res = fn();
+        double t =
+            chrono::duration<double>(chrono::steady_clock::now() - st).count();
+        return pair(t, res);
+    };
+
+    size_t mem1 = 0, mem2 = 0;
+    auto [t1, r1] = timeit([&] {
+        vector<Node*> root(n + 1);
+        root[0] = build(0, n);
+        for (int i = 0; i < n; i++) {
+            root[i + 1] = add(root[i], 0, n, a[i], 1);
+        }
+        // 2n - 1 个 build 节点，每次 add 新建 __lg(n) + 2 个左右，不含 malloc 头
+        mem1 = (2LL * n + 1LL * n * (__lg(n) + 2)) * sizeof(Node);
+        long long chk = 0;
+        for (auto [l, r, k] : qs) {
+            chk += query(root[l], root[r], 0, n, k);
+        }
+        return chk;
+    });
+
+    auto [t2, r2] = timeit([&] {
+        PersistentSegTree seg(n, 1LL * n * (__lg(n) + 2));
+        for (int i = 0; i < n; i++) {
+            seg.add(i, a[i], 1);
+        }
+        mem2 = seg.memory();
+        long long chk = 0;
+        for (auto [l, r, k] : qs) {
+            chk += seg.query(l, r, k);
+        }
+        return chk;
+    });
+
+    assert(r1 == r2);
+    cout << "pointer: " << mem1 / 1048576 << "MB+, " << t1 << "s\n";
+    cout << "pool   : " << mem2 / 1048576 << "MB, " << t2 << "s\n";
+}
+
+int main() {
+    benchmark();
+    return 0;
+}
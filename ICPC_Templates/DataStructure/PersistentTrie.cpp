@@ -2,13 +2,142 @@
 // 功能：维护历史版本的字典树，常用于01Trie求区间异或最值
 // 复杂度：O(log V) per operation, V为值域
 // 应用：区间异或最大值、第k大异或值
+// PersistentTrieT<LOG, T> 支持 64 位，插入与查询均为循环实现，另有批量构建与批量查询
+// save() 写出节点数组与版本根，MappedPersistentTrie 用 mmap 只读加载，无需重建
 
 #include <bits/stdc++.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 using namespace std;
 
+// ---- 可选：快照持久化。不需要时可连同 save() 与 Mapped* 一起删去 ----
+// 与 PersistentTrie.cpp / PersistentSegTree.cpp 中的同一段相同，用宏防止重复定义
+#ifndef SNAPSHOT_HELPERS
+#define SNAPSHOT_HELPERS
+// 只读内存映射文件，多个进程映射同一文件时共享物理页
+struct MappedFile {
+    const char* data = nullptr;
+    size_t len = 0;
+
+    MappedFile() {}
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() {
+        if (data) {
+            munmap((void*)data, len);
+        }
+    }
+
+    bool open(const string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) < 0 || st.st_size == 0) {
+            close(fd);
+            return false;
+        }
+        len = st.st_size;
+        void* p = mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (p == MAP_FAILED) {
+            return false;
+        }
+        data = (const char*)p;
+        return true;
+    }
+};
+
+// 文件格式：文件头，随后是 nodeCount 个节点、rootCount 个版本根，
+// 再是 aliveCount 个版本存活标记（为 0 表示全部存活，否则等于 rootCount）
+struct SnapshotHeader {
+    char magic[8];
+    long long param;  // 与结构相关的参数（位数或值域大小）
+    long long nodeCount, rootCount, aliveCount;
+};
+
+template <class Node>
+bool writeSnapshot(const string& path, const char* magic, long long param,
+                   const vector<Node>& nodes, const vector<int>& roots,
+                   const vector<char>& alive = {}) {
+    static_assert(is_trivially_copyable_v<Node>);
+    FILE* fp = fopen(path.c_str(), "wb");
+    if (!fp) {
+        return false;
+    }
+    SnapshotHeader h{};
+    memcpy(h.magic, magic, 8);
+    h.param = param;
+    h.nodeCount = nodes.size();
+    h.rootCount = roots.size();
+    h.aliveCount = alive.size();
+    bool ok = fwrite(&h, sizeof(h), 1, fp) == 1 &&
+              fwrite(nodes.data(), sizeof(Node), nodes.size(), fp) ==
+                  nodes.size() &&
+              fwrite(roots.data(), sizeof(int), roots.size(), fp) ==
+                  roots.size() &&
+              fwrite(alive.data(), 1, alive.size(), fp) == alive.size();
+    return fclose(fp) == 0 && ok;
+}
+
+// 校验文件头与长度，成功时给出节点、版本根与存活标记的指针（无标记时为 nullptr）
+// 及节点数、版本数；各计数来自文件，先逐个与剩余长度比较再相乘，避免溢出
+// 节点内的下标由调用者用 checkSnapshotIndex 校验
+template <class Node>
+bool readSnapshot(const MappedFile& f, const char* magic, long long& param,
+                  const Node*& nodes, const int*& roots, const char*& alive,
+                  long long& nodeCount, long long& rootCount) {
+    if (f.len < sizeof(SnapshotHeader)) {
+        return false;
+    }
+    SnapshotHeader h;
+    memcpy(&h, f.data, sizeof(h));
+    if (memcmp(h.magic, magic, 8) != 0 || h.nodeCount < 0 ||
+        h.rootCount < 0 || h.aliveCount < 0) {
+        return false;
+    }
+    size_t rest = f.len - sizeof(h);
+    if ((unsigned long long)h.nodeCount > rest / sizeof(Node)) {
+        return false;
+    }
+    rest -= h.nodeCount * sizeof(Node);
+    if ((unsigned long long)h.rootCount > rest / sizeof(int)) {
+        return false;
+    }
+    rest -= h.rootCount * sizeof(int);
+    if ((unsigned long long)h.aliveCount != rest ||
+        (h.aliveCount != 0 && h.aliveCount != h.rootCount)) {
+        return false;
+    }
+    param = h.param;
+    nodes = (const Node*)(f.data + sizeof(h));
+    roots = (const int*)(f.data + sizeof(h) + h.nodeCount * sizeof(Node));
+    alive = h.aliveCount ? (const char*)(roots + h.rootCount) : nullptr;
+    nodeCount = h.nodeCount;
+    rootCount = h.rootCount;
+    return true;
+}
+
+// 所有版本根都须是 [0, nodeCount) 内的下标；损坏或版本不符的文件在打开时即失败
+inline bool checkSnapshotIndex(const int* a, long long cnt, long long nodeCount) {
+    for (long long i = 0; i < cnt; i++) {
+        if (a[i] < 0 || a[i] >= nodeCount) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif  // SNAPSHOT_HELPERS
+// ---- 快照持久化结束 ----
+
 const int MAXLOG = 30;  // 数值的最大位数
 
-struct PersistentTrie {
+// LOG 为位数，T 为值类型（64 位时用 unsigned long long）
+template <int LOG = MAXLOG, class T = int>
+struct PersistentTrieT {
     struct Node {
         int ch[2];  // 左右儿子（0和1）
         int cnt;    // 该节点代表的数出现次数
@@ -19,127 +148,224 @@ struct PersistentTrie {
     vector<Node> nodes;
     vector<int> roots;  // 每个版本的根节点
 
-    PersistentTrie() {
+    PersistentTrieT() {
         nodes.push_back(Node());  // 0号节点为空节点
         roots.push_back(0);       // 初始版本（空树）
     }
 
-    int new_node() {
+    // 批量构建：版本 i 为插入 a[0, i) 后的树，节点一次性预留
+    PersistentTrieT(const vector<T>& a) {
+        nodes.reserve(1 + a.size() * (LOG + 1));
+        roots.reserve(a.size() + 1);
         nodes.push_back(Node());
-        return nodes.size() - 1;
+        roots.push_back(0);
+        for (int i = 0; i < (int)a.size(); i++) {
+            insert(i, a[i]);
+        }
     }
 
-    // 在版本 ver 的基础上插入 x，返回新版本号
-    int insert(int ver, int x, int delta = 1) {
-        int new_root = _insert(roots[ver], x, MAXLOG - 1, delta);
-        roots.push_back(new_root);
-        return roots.size() - 1;
+    static int bitAt(T x, int bit) { return x >> bit & 1; }
+
+    int clone(int u) {
+        nodes.push_back(nodes[u]);
+        return nodes.size() - 1;
     }
 
-    int _insert(int old, int x, int bit, int delta) {
-        int cur = new_node();
-        nodes[cur] = nodes[old];
+    // 在版本 ver 的基础上插入 x，返回新版本号
+    int insert(int ver, T x, int delta = 1) {
+        int old = roots[ver];
+        int cur = clone(old);
+        roots.push_back(cur);
         nodes[cur].cnt += delta;
-
-        if (bit < 0) return cur;
-
-        int d = (x >> bit) & 1;
-        nodes[cur].ch[d] = _insert(nodes[old].ch[d], x, bit - 1, delta);
-
-        return cur;
+        for (int bit = LOG - 1; bit >= 0; bit--) {
+            int d = bitAt(x, bit);
+            old = nodes[old].ch[d];
+            int nxt = clone(old);
+            nodes[nxt].cnt += delta;
+            nodes[cur].ch[d] = nxt;
+            cur = nxt;
+        }
+        return roots.size() - 1;
     }
 
     // 查询版本 [l, r] 之间插入的数中，与 x 异或的最大值
-    int query_max_xor(int l, int r, int x) {
-        return _query_max_xor(roots[l], roots[r], x, MAXLOG - 1);
+    T query_max_xor(int l, int r, T x) const {
+        int u = roots[l], v = roots[r];
+        T res = 0;
+        for (int bit = LOG - 1; bit >= 0; bit--) {
+            int d = bitAt(x, bit) ^ 1;  // 希望走的方向
+            if (nodes[nodes[v].ch[d]].cnt - nodes[nodes[u].ch[d]].cnt > 0) {
+                res |= T(1) << bit;
+            } else {
+                d ^= 1;
+            }
+            u = nodes[u].ch[d];
+            v = nodes[v].ch[d];
+        }
+        return res;
     }
 
-    int _query_max_xor(int left_ver, int right_ver, int x, int bit) {
-        if (bit < 0) return 0;
-
-        int d = (x >> bit) & 1;
-        int want = d ^ 1;  // 希望走的方向
-
-        // 检查区间内是否有数走want方向
-        int cnt_want = nodes[nodes[right_ver].ch[want]].cnt -
-                       nodes[nodes[left_ver].ch[want]].cnt;
-
-        if (cnt_want > 0) {
-            return (1 << bit) + _query_max_xor(nodes[left_ver].ch[want],
-                                               nodes[right_ver].ch[want], x,
-                                               bit - 1);
-        } else {
-            return _query_max_xor(nodes[left_ver].ch[d], nodes[right_ver].ch[d],
-                                  x, bit - 1);
+    // 批量 query_max_xor：每 G 个询问同步逐位下降，并预取下一层节点以隐藏访存延迟
+    vector<T> query_max_xor(const vector<tuple<int, int, T>>& qs) const {
+        constexpr int G = 8;
+        int q = qs.size();
+        vector<T> ans(q);
+        for (int s = 0; s < q; s += G) {
+            int g = min(G, q - s);
+            int u[G], v[G];
+            T x[G], res[G];
+            for (int i = 0; i < g; i++) {
+                auto [l, r, y] = qs[s + i];
+                u[i] = roots[l];
+                v[i] = roots[r];
+                x[i] = y;
+                res[i] = 0;
+            }
+            for (int bit = LOG - 1; bit >= 0; bit--) {
+                for (int i = 0; i < g; i++) {
+                    int d = bitAt(x[i], bit) ^ 1;
+                    if (nodes[nodes[v[i]].ch[d]].cnt -
+                            nodes[nodes[u[i]].ch[d]].cnt > 0) {
+                        res[i] |= T(1) << bit;
+                    } else {
+                        d ^= 1;
+                    }
+                    u[i] = nodes[u[i]].ch[d];
+                    v[i] = nodes[v[i]].ch[d];
+                    __builtin_prefetch(&nodes[u[i]]);
+                    __builtin_prefetch(&nodes[v[i]]);
+                }
+            }
+            for (int i = 0; i < g; i++) {
+                ans[s + i] = res[i];
+            }
         }
+        return ans;
     }
 
     // 查询版本 [l, r] 之间插入的数中，与 x 异或的最小值
-    int query_min_xor(int l, int r, int x) {
-        return _query_min_xor(roots[l], roots[r], x, MAXLOG - 1);
-    }
-
-    int _query_min_xor(int left_ver, int right_ver, int x, int bit) {
-        if (bit < 0) return 0;
-
-        int d = (x >> bit) & 1;
-
-        // 优先走相同方向
-        int cnt_same = nodes[nodes[right_ver].ch[d]].cnt -
-                       nodes[nodes[left_ver].ch[d]].cnt;
-
-        if (cnt_same > 0) {
-            return _query_min_xor(nodes[left_ver].ch[d], nodes[right_ver].ch[d],
-                                  x, bit - 1);
-        } else {
-            return (1 << bit) + _query_min_xor(nodes[left_ver].ch[d ^ 1],
-                                               nodes[right_ver].ch[d ^ 1], x,
-                                               bit - 1);
+    T query_min_xor(int l, int r, T x) const {
+        int u = roots[l], v = roots[r];
+        T res = 0;
+        for (int bit = LOG - 1; bit >= 0; bit--) {
+            int d = bitAt(x, bit);  // 优先走相同方向
+            if (nodes[nodes[v].ch[d]].cnt - nodes[nodes[u].ch[d]].cnt <= 0) {
+                res |= T(1) << bit;
+                d ^= 1;
+            }
+            u = nodes[u].ch[d];
+            v = nodes[v].ch[d];
         }
+        return res;
     }
 
     // 查询版本 ver 中小于等于 x 的数的个数
-    int count_le(int ver, int x) {
-        return _count_le(roots[ver], x, MAXLOG - 1);
+    int count_le(int ver, T x) const {
+        int u = roots[ver], res = 0;
+        for (int bit = LOG - 1; bit >= 0 && u; bit--) {
+            int d = bitAt(x, bit);
+            if (d == 1) {
+                // 如果当前位是1，左子树（0）的所有数都小于x
+                res += nodes[nodes[u].ch[0]].cnt;
+            }
+            u = nodes[u].ch[d];
+        }
+        return res + nodes[u].cnt;
     }
 
-    int _count_le(int u, int x, int bit) {
-        if (bit < 0 || u == 0) return nodes[u].cnt;
-
-        int d = (x >> bit) & 1;
-        int res = 0;
-
-        if (d == 1) {
-            // 如果当前位是1，左子树（0）的所有数都小于x
-            res += nodes[nodes[u].ch[0]].cnt;
+    // 查询版本 [l, r] 之间插入的数中的第 k 小（k从1开始）
+    T kth_smallest(int l, int r, int k) const {
+        int u = roots[l], v = roots[r];
+        T res = 0;
+        for (int bit = LOG - 1; bit >= 0; bit--) {
+            int cnt = nodes[nodes[v].ch[0]].cnt - nodes[nodes[u].ch[0]].cnt;
+            int d = 0;
+            if (k > cnt) {
+                k -= cnt;
+                d = 1;
+                res |= T(1) << bit;
+            }
+            u = nodes[u].ch[d];
+            v = nodes[v].ch[d];
         }
-
-        res += _count_le(nodes[u].ch[d], x, bit - 1);
         return res;
     }
 
-    // 查询版本 [l, r] 之间插入的数中的第 k 小（k从1开始）
-    int kth_smallest(int l, int r, int k) {
-        return _kth_smallest(roots[l], roots[r], k, MAXLOG - 1);
+    bool save(const string& path) const {
+        return writeSnapshot(path, "PERSTRIE", LOG, nodes, roots);
     }
+};
 
-    int _kth_smallest(int left_ver, int right_ver, int k, int bit) {
-        if (bit < 0) return 0;
+using PersistentTrie = PersistentTrieT<>;
+
+// 从 PersistentTrieT::save() 写出的文件只读加载，查询直接访问映射的页
+template <int LOG = MAXLOG, class T = int>
+struct MappedPersistentTrieT {
+    using Node = typename PersistentTrieT<LOG, T>::Node;
+
+    MappedFile file;
+    const Node* nodes = nullptr;
+    const int* roots = nullptr;
+    int versions = 0;
+
+    // 打开时检查所有版本根与儿子下标都在节点数组内，O(节点数)
+    bool open(const string& path) {
+        long long bits, nodeCount, rootCount;
+        const char* alive;
+        if (!file.open(path) ||
+            !readSnapshot(file, "PERSTRIE", bits, nodes, roots, alive,
+                          nodeCount, rootCount) ||
+            bits != LOG || nodeCount < 1 || rootCount > INT_MAX ||
+            !checkSnapshotIndex(roots, rootCount, nodeCount)) {
+            return false;
+        }
+        for (long long i = 0; i < nodeCount; i++) {
+            if (!checkSnapshotIndex(nodes[i].ch, 2, nodeCount)) {
+                return false;
+            }
+        }
+        versions = rootCount;
+        return true;
+    }
 
-        int left_cnt = nodes[nodes[right_ver].ch[0]].cnt -
-                       nodes[nodes[left_ver].ch[0]].cnt;
+    // 同 PersistentTrieT::query_max_xor
+    T query_max_xor(int l, int r, T x) const {
+        int u = roots[l], v = roots[r];
+        T res = 0;
+        for (int bit = LOG - 1; bit >= 0; bit--) {
+            int d = (x >> bit & 1) ^ 1;
+            if (nodes[nodes[v].ch[d]].cnt - nodes[nodes[u].ch[d]].cnt > 0) {
+                res |= T(1) << bit;
+            } else {
+                d ^= 1;
+            }
+            u = nodes[u].ch[d];
+            v = nodes[v].ch[d];
+        }
+        return res;
+    }
 
-        if (k <= left_cnt) {
-            return _kth_smallest(nodes[left_ver].ch[0], nodes[right_ver].ch[0],
-                                 k, bit - 1);
-        } else {
-            return (1 << bit) + _kth_smallest(nodes[left_ver].ch[1],
-                                              nodes[right_ver].ch[1],
-                                              k - left_cnt, bit - 1);
+    // 同 PersistentTrieT::kth_smallest
+    T kth_smallest(int l, int r, int k) const {
+        int u = roots[l], v = roots[r];
+        T res = 0;
+        for (int bit = LOG - 1; bit >= 0; bit--) {
+            int cnt = nodes[nodes[v].ch[0]].cnt - nodes[nodes[u].ch[0]].cnt;
+            int d = 0;
+            if (k > cnt) {
+                k -= cnt;
+                d = 1;
+                res |= T(1) << bit;
+            }
+            u = nodes[u].ch[d];
+            v = nodes[v].ch[d];
         }
+        return res;
     }
 };
 
+using MappedPersistentTrie = MappedPersistentTrieT<>;
+
 // 使用示例1：区间异或最大值
 void example1() {
     int n, m;
@@ -234,6 +460,27 @@ void example3() {
     }
 }
 
+// 快照示例：批量构建后 save()，再映射回来对比查询结果
+void trieSnapshotExample(const string& path = "ptrie.snap") {
+    vector<int> a = {5, 2, 7, 1, 12, 9};
+    PersistentTrie t(a);
+    if (!t.save(path)) {
+        return;
+    }
+    MappedPersistentTrie m;
+    if (m.open(path)) {
+        int n = a.size();
+        for (int l = 0; l < n; l++) {
+            for (int r = l + 1; r <= n; r++) {
+                assert(m.query_max_xor(l, r, 6) == t.query_max_xor(l, r, 6));
+                assert(m.kth_smallest(l, r, 1) == t.kth_smallest(l, r, 1));
+            }
+        }
+        cout << m.kth_smallest(0, n, 3) << "\n";  // 5
+    }
+    remove(path.c_str());
+}
+
 int main() {
     ios::sync_with_stdio(false);
     cin.tie(nullptr);
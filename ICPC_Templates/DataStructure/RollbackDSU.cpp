@@ -2,18 +2,26 @@
  * 可撤销并查集 (Rollback DSU)
  * 功能：支持撤销操作的并查集
  * 应用：维护动态图的连通性
+ * DynamicConnectivity：线段树分治，离线处理加边、删边、连通性/连通块数询问，
+ * 复杂度 O((n + q) log q log n)
  */
 #include <bits/stdc++.h>
 using namespace std;
 
 struct RollbackDSU {
     vector<int> f, siz;
-    stack<pair<int, int>> history;
+    vector<pair<int, int>> history;
 
-    RollbackDSU(int n) {
+    RollbackDSU() {}
+    RollbackDSU(int n, int reserve = 0) { init(n, reserve); }
+
+    // reserve 为同时保留的最多合并次数，预留后 merge 不再分配内存
+    void init(int n, int reserve = 0) {
         f.resize(n);
         iota(f.begin(), f.end(), 0);
         siz.assign(n, 1);
+        history.clear();
+        history.reserve(reserve);
     }
 
     int find(int x) {
@@ -27,21 +35,21 @@ struct RollbackDSU {
         x = find(x);
         y = find(y);
         if (x == y) {
-            history.push({-1, -1});
+            history.push_back({-1, -1});
             return false;
         }
         if (siz[x] < siz[y]) {
             swap(x, y);
         }
-        history.push({x, y});
+        history.push_back({x, y});
         f[y] = x;
         siz[x] += siz[y];
         return true;
     }
 
     void rollback() {
-        auto [x, y] = history.top();
-        history.pop();
+        auto [x, y] = history.back();
+        history.pop_back();
         if (x == -1) return;
         f[y] = y;
         siz[x] -= siz[y];
@@ -55,3 +63,107 @@ struct RollbackDSU {
         }
     }
 };
+
+// 离线动态图连通性：按调用顺序记录事件，solve() 一次性回答所有询问
+struct DynamicConnectivity {
+    int n;
+    RollbackDSU dsu;
+    // 每条边的存在时间段 [l, r)，按时间挂到线段树节点上
+    vector<array<int, 4>> seg;  // {l, r, u, v}
+    map<pair<int, int>, vector<int>> open;  // 未删除的边 -> 加入时间
+    vector<array<int, 3>> qs;               // {type, u, v}，type 0: 连通，1: 块数
+    int T = 0;
+    vector<int> head, nxt, eid, ans;  // 节点 p 上的边：从 head[p] 沿 nxt 的链表
+
+    DynamicConnectivity(int n_) : n(n_) {}
+
+    void addEdge(int u, int v) {
+        if (u > v) swap(u, v);
+        open[{u, v}].push_back(qs.size());
+    }
+
+    // 删除一条当前存在的边；边不存在时忽略并返回 false
+    bool removeEdge(int u, int v) {
+        if (u > v) swap(u, v);
+        auto it = open.find({u, v});
+        if (it == open.end()) {
+            return false;
+        }
+        int l = it->second.back();
+        it->second.pop_back();
+        if (it->second.empty()) {
+            open.erase(it);
+        }
+        seg.push_back({l, (int)qs.size(), u, v});
+        return true;
+    }
+
+    // 询问 u、v 是否连通，返回询问编号
+    int query(int u, int v) {
+        qs.push_back({0, u, v});
+        return qs.size() - 1;
+    }
+
+    // 询问当前连通块个数，返回询问编号
+    int queryCount() {
+        qs.push_back({1, 0, 0});
+        return qs.size() - 1;
+    }
+
+    void insert(int p, int l, int r, int x, int y, int id) {
+        if (l >= y || r <= x) {
+            return;
+        }
+        if (l >= x && r <= y) {
+            nxt.push_back(head[p]);
+            eid.push_back(id);
+            head[p] = nxt.size() - 1;
+            return;
+        }
+        int m = (l + r) / 2;
+        insert(2 * p, l, m, x, y, id);
+        insert(2 * p + 1, m, r, x, y, id);
+    }
+
+    void dfs(int p, int l, int r, int comp) {
+        int snap = dsu.snapshot();
+        for (int i = head[p]; i != -1; i = nxt[i]) {
+            comp -= dsu.merge(seg[eid[i]][2], seg[eid[i]][3]);
+        }
+        if (r - l == 1) {
+            auto [type, u, v] = qs[l];
+            ans[l] = type == 0 ? dsu.find(u) == dsu.find(v) : comp;
+        } else {
+            int m = (l + r) / 2;
+            dfs(2 * p, l, m, comp);
+            dfs(2 * p + 1, m, r, comp);
+        }
+        dsu.rollbackTo(snap);
+    }
+
+    // ans[i] 为第 i 个询问的答案（询问编号由 query/queryCount 返回）
+    vector<int> solve() {
+        T = qs.size();
+        for (auto& [key, starts] : open) {
+            for (int l : starts) {
+                seg.push_back({l, T, key.first, key.second});
+            }
+        }
+        open.clear();
+        ans.assign(T, 0);
+        if (T == 0) {
+            return ans;
+        }
+        // 每条边在一条根到叶子的路径上至多出现一次
+        int m = seg.size();
+        dsu.init(n, m);
+        head.assign(4 << __lg(T), -1);
+        nxt.clear();
+        eid.clear();
+        for (int i = 0; i < m; i++) {
+            insert(1, 0, T, seg[i][0], seg[i][1], i);
+        }
+        dfs(1, 0, T, n);
+        return ans;
+    }
+};
@@ -2,60 +2,297 @@
 // 功能：处理子集和相关的DP问题
 // 复杂度：O(n * 2^n)
 // 应用：子集枚举、状压DP优化
+// sos_transform 为原地变换：低位在 L1/L2 大小的块内做完，高位按 6 位一组合并成一遍，
+// 每遍顺序扫描整个数组，内层循环为连续数组上的加减，可被编译器向量化（-O3 -march=native），
+// 各块、各组之间互不相关，按线程划分
 
 #include <bits/stdc++.h>
 using namespace std;
 using ll = long long;
 
-// 基础SOS DP：计算所有子集的和
-// dp[mask] = sum of a[submask] for all submask of mask
-template <typename T>
-vector<T> sosdp(const vector<T>& a) {
-    int n = __builtin_ctz(a.size());  // log2(size)
-    vector<T> dp = a;
+template <class T>
+constexpr T power(T a, ll b) {
+    T res = 1;
+    for (; b; b /= 2, a *= a) {
+        if (b % 2) {
+            res *= a;
+        }
+    }
+    return res;
+}
 
-    for (int i = 0; i < n; i++) {
-        for (int mask = 0; mask < (1 << n); mask++) {
-            if (mask & (1 << i)) {
-                dp[mask] += dp[mask ^ (1 << i)];
+constexpr ll mul(ll a, ll b, ll p) {
+    ll res = a * b - ll(1.L * a * b / p) * p;
+    res %= p;
+    if (res < 0) {
+        res += p;
+    }
+    return res;
+}
+
+template <int P>
+struct MInt {
+    int x;
+    constexpr MInt() : x{} {}
+    constexpr MInt(ll x) : x{norm(x % getMod())} {}
+
+    static int Mod;
+    constexpr static int getMod() {
+        if (P > 0) {
+            return P;
+        } else {
+            return Mod;
+        }
+    }
+    constexpr static void setMod(int Mod_) { Mod = Mod_; }
+    constexpr int norm(int x) const {
+        if (x < 0) {
+            x += getMod();
+        }
+        if (x >= getMod()) {
+            x -= getMod();
+        }
+        return x;
+    }
+    constexpr int val() const { return x; }
+    explicit constexpr operator int() const { return x; }
+    constexpr MInt operator-() const {
+        MInt res;
+        res.x = norm(getMod() - x);
+        return res;
+    }
+    constexpr MInt inv() const {
+        assert(x != 0);
+        return power(*this, getMod() - 2);
+    }
+    constexpr MInt& operator*=(MInt rhs) & {
+        x = 1LL * x * rhs.x % getMod();
+        return *this;
+    }
+    constexpr MInt& operator+=(MInt rhs) & {
+        x = norm(x + rhs.x);
+        return *this;
+    }
+    constexpr MInt& operator-=(MInt rhs) & {
+        x = norm(x - rhs.x);
+        return *this;
+    }
+    constexpr MInt& operator/=(MInt rhs) & { return *this *= rhs.inv(); }
+    friend constexpr MInt operator*(MInt lhs, MInt rhs) {
+        MInt res = lhs;
+        res *= rhs;
+        return res;
+    }
+    friend constexpr MInt operator+(MInt lhs, MInt rhs) {
+        MInt res = lhs;
+        res += rhs;
+        return res;
+    }
+    friend constexpr MInt operator-(MInt lhs, MInt rhs) {
+        MInt res = lhs;
+        res -= rhs;
+        return res;
+    }
+    friend constexpr MInt operator/(MInt lhs, MInt rhs) {
+        MInt res = lhs;
+        res /= rhs;
+        return res;
+    }
+    friend constexpr istream& operator>>(istream& is, MInt& a) {
+        ll v;
+        is >> v;
+        a = MInt(v);
+        return is;
+    }
+    friend constexpr ostream& operator<<(ostream& os, const MInt& a) {
+        return os << a.val();
+    }
+    friend constexpr bool operator==(MInt lhs, MInt rhs) {
+        return lhs.val() == rhs.val();
+    }
+    friend constexpr bool operator!=(MInt lhs, MInt rhs) {
+        return lhs.val() != rhs.val();
+    }
+};
+
+template <>
+int MInt<0>::Mod = 998244353;
+
+template <int V, int P>
+constexpr MInt<P> CInv = MInt<P>(V).inv();
+
+constexpr int P = 998244353;
+using Z = MInt<P>;
+
+// 加减策略：PlusOp 直接使用 +、-（整数自然溢出、MInt 等均适用）
+struct PlusOp {
+    template <typename T>
+    static T add(T a, T b) {
+        return a + b;
+    }
+    template <typename T>
+    static T sub(T a, T b) {
+        return a - b;
+    }
+};
+
+// 模 P 加减，值在 [0, P) 且 P < 2^31；写成无分支的 min 形式以便向量化
+template <unsigned P>
+struct ModOp {
+    static unsigned add(unsigned a, unsigned b) {
+        unsigned s = a + b;
+        return min(s, s - P);
+    }
+    static unsigned sub(unsigned a, unsigned b) {
+        unsigned s = a - b;
+        return min(s, s + P);
+    }
+};
+
+// 把 [0, n) 均分给 threads 个线程执行 f(l, r)
+template <typename F>
+void parallel_for(ll n, int threads, F f) {
+    threads = max(1, (int)min<ll>(threads, n));
+    if (threads == 1) {
+        f(0LL, n);
+        return;
+    }
+    vector<thread> ths;
+    for (int t = 0; t < threads; t++) {
+        ths.emplace_back(f, n * t / threads, n * (t + 1) / threads);
+    }
+    for (auto& th : ths) {
+        th.join();
+    }
+}
+
+// x 为某一位为 0 的一半，y 为该位为 1 的一半
+template <typename Op, bool SUPER, bool INV, typename T>
+void sos_combine(T* __restrict x, T* __restrict y, int len) {
+    for (int j = 0; j < len; j++) {
+        if constexpr (SUPER) {
+            x[j] = INV ? Op::sub(x[j], y[j]) : Op::add(x[j], y[j]);
+        } else {
+            y[j] = INV ? Op::sub(y[j], x[j]) : Op::add(y[j], x[j]);
+        }
+    }
+}
+
+// 最低 3 位：每 8 个元素展开成固定的 12 次加减，避免长度为 1、2、4 的短循环
+template <typename Op, bool SUPER, bool INV, typename T>
+void sos_low3(T* p, int len) {
+    for (int s = 0; s < len; s += 8) {
+        T* q = p + s;
+        for (int h = 1; h < 8; h <<= 1) {
+            for (int j = 0; j < 8; j++) {
+                if (j & h) {
+                    sos_combine<Op, SUPER, INV>(q + (j ^ h), q + j, 1);
+                }
             }
         }
     }
+}
+
+// 每个下标对应 W 个连续元素（W > 1 用于秩变换），整体作为一个元素参与变换
+template <typename Op, bool SUPER, bool INV, typename T>
+void sos_transform_impl(T* a, int n, int threads, int W = 1) {
+    // 低 t 位：每个 2^t 的块独立完成（块约 64KB）
+    int t = 0;
+    while (t < n && ((ll)W << (t + 1)) * sizeof(T) <= (1 << 16)) {
+        t++;
+    }
+    parallel_for(1LL << (n - t), threads, [&](ll l, ll r) {
+        for (ll blk = l; blk < r; blk++) {
+            T* p = a + (blk << t) * W;
+            int i = 0;
+            if (W == 1 && t >= 3) {
+                sos_low3<Op, SUPER, INV>(p, 1 << t);
+                i = 3;
+            }
+            for (; i < t; i++) {
+                int h = 1 << i;
+                for (int s = 0; s < (1 << t); s += 2 * h) {
+                    sos_combine<Op, SUPER, INV>(p + (ll)s * W,
+                                                p + (ll)(s + h) * W, h * W);
+                }
+            }
+        }
+    });
+    // 高位每 6 位一组 [lo, hi)：固定其余位，取 2^g 段各 C 个连续元素
+    // （每段约 1KB，共约 64KB）在缓存中做完这一组
+    int c = 0;
+    while (c < t && ((ll)W << (c + 1)) * sizeof(T) <= (1 << 10)) {
+        c++;
+    }
+    for (int lo = t; lo < n; lo += 6) {
+        int hi = min(n, lo + 6), g = hi - lo, C = (1 << c) * W;
+        int lowBits = lo - c;
+        parallel_for(1LL << (n - g - c), threads, [&](ll l, ll r) {
+            for (ll e = l; e < r; e++) {
+                ll low = e & ((1LL << lowBits) - 1), high = e >> lowBits;
+                T* p = a + ((low << c) | (high << hi)) * W;
+                for (int b = 0; b < g; b++) {
+                    for (int k = 0; k < (1 << g); k++) {
+                        if (!(k >> b & 1)) {
+                            sos_combine<Op, SUPER, INV>(
+                                p + ((ll)k << lo) * W,
+                                p + ((ll)(k | 1 << b) << lo) * W, C);
+                        }
+                    }
+                }
+            }
+        });
+    }
+}
+
+// 线程数约定：默认 1 为单线程；显式传入 <= 0 时取 hardware_concurrency()；
+// 规模小于 2^minN 时总是单线程
+int sos_threads(int threads, int n, int minN) {
+    if (threads <= 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    return n < minN ? 1 : threads;
+}
+
+// 原地变换，a.size() 为 2 的幂：
+// super 为 false 时为子集方向（a[mask] 变为所有子集之和），为 true 时为超集方向；
+// inv 为 true 时为逆变换（Möbius）；Op 为加减策略，如 ModOp<998244353>
+template <typename Op = PlusOp, typename T>
+void sos_transform(vector<T>& a, bool super = false, bool inv = false,
+                   int threads = 1) {
+    int n = __builtin_ctz(a.size());
+    threads = sos_threads(threads, n, 16);
+    if (!super && !inv) {
+        sos_transform_impl<Op, false, false>(a.data(), n, threads);
+    } else if (!super) {
+        sos_transform_impl<Op, false, true>(a.data(), n, threads);
+    } else if (!inv) {
+        sos_transform_impl<Op, true, false>(a.data(), n, threads);
+    } else {
+        sos_transform_impl<Op, true, true>(a.data(), n, threads);
+    }
+}
 
+// 基础SOS DP：计算所有子集的和
+// dp[mask] = sum of a[submask] for all submask of mask
+template <typename T>
+vector<T> sosdp(const vector<T>& a) {
+    vector<T> dp = a;
+    sos_transform(dp, false, false, 1);
     return dp;
 }
 
 // 高维前缀和（另一种实现）
 template <typename T>
 void fwt_or(vector<T>& a, bool inv = false) {
-    int n = a.size();
-    for (int len = 2, mid = 1; len <= n; mid = len, len <<= 1) {
-        for (int i = 0; i < n; i += len) {
-            for (int j = 0; j < mid; j++) {
-                if (!inv) {
-                    a[i + j + mid] += a[i + j];
-                } else {
-                    a[i + j + mid] -= a[i + j];
-                }
-            }
-        }
-    }
+    sos_transform(a, false, inv, 1);
 }
 
 // 超集版本：dp[mask] = sum of a[supermask] for all supermask of mask
 template <typename T>
 vector<T> sosdp_super(const vector<T>& a) {
-    int n = __builtin_ctz(a.size());
     vector<T> dp = a;
-
-    for (int i = 0; i < n; i++) {
-        for (int mask = (1 << n) - 1; mask >= 0; mask--) {
-            if (!(mask & (1 << i))) {
-                dp[mask] += dp[mask | (1 << i)];
-            }
-        }
-    }
-
+    sos_transform(dp, true, false, 1);
     return dp;
 }
 
@@ -100,54 +337,172 @@ void example1() {
 // 应用2：子集卷积
 // c[mask] = sum over all (s1, s2) where s1 & s2 = 0 and s1 | s2 = mask of a[s1]
 // * b[s2]
+// 秩变换数组 f[mask * (n + 1) + k]：同一 mask 的各秩连续存放，
+// 变换时每个 mask 的 n + 1 个数作为一个整体，逐点运算也只访问这一段
 template <typename T>
-vector<T> subset_convolution(const vector<T>& a, const vector<T>& b) {
-    int n = __builtin_ctz(a.size());
-    int sz = 1 << n;
-
-    // 按popcount分层
-    vector<vector<T>> fa(n + 1, vector<T>(sz, 0));
-    vector<vector<T>> fb(n + 1, vector<T>(sz, 0));
+vector<T> ranked_zeta(const vector<T>& a, int threads = 1) {
+    int n = __builtin_ctz(a.size()), W = n + 1;
+    vector<T> f((size_t)W << n);
+    for (int mask = 0; mask < (1 << n); mask++) {
+        f[(size_t)mask * W + __builtin_popcount(mask)] = a[mask];
+    }
+    threads = sos_threads(threads, n, 12);
+    sos_transform_impl<PlusOp, false, false>(f.data(), n, threads, W);
+    return f;
+}
 
-    for (int mask = 0; mask < sz; mask++) {
-        fa[__builtin_popcount(mask)][mask] = a[mask];
-        fb[__builtin_popcount(mask)][mask] = b[mask];
+// 逆变换后取出每个 mask 与其 popcount 相同的那一秩
+template <typename T>
+vector<T> ranked_moebius(vector<T>& f, int n, int threads = 1) {
+    int W = n + 1;
+    threads = sos_threads(threads, n, 12);
+    sos_transform_impl<PlusOp, false, true>(f.data(), n, threads, W);
+    vector<T> c(1 << n);
+    for (int mask = 0; mask < (1 << n); mask++) {
+        c[mask] = f[(size_t)mask * W + __builtin_popcount(mask)];
     }
+    return c;
+}
+
+// 对每个 mask 的秩多项式原地执行 fn(T* p)，p[0..n] 为该 mask 的各秩
+template <typename T, typename F>
+void ranked_pointwise(vector<T>& f, int n, F fn, int threads = 1) {
+    int W = n + 1;
+    threads = sos_threads(threads, n, 12);
+    parallel_for(1LL << n, threads, [&](ll l, ll r) {
+        for (ll mask = l; mask < r; mask++) {
+            fn(f.data() + mask * W);
+        }
+    });
+}
 
-    // 对每一层做SOS DP
-    for (int i = 0; i <= n; i++) {
-        fa[i] = sosdp(fa[i]);
-        fb[i] = sosdp(fb[i]);
+// sum x[i] * y[len - 1 - i]，即秩多项式乘积的一项
+template <typename T>
+T dot_rev(const T* x, const T* y, int len) {
+    T s = 0;
+    for (int i = 0; i < len; i++) {
+        s += x[i] * y[len - 1 - i];
     }
+    return s;
+}
 
-    // 卷积
-    vector<vector<T>> fc(n + 1, vector<T>(sz, 0));
-    for (int i = 0; i <= n; i++) {
-        for (int j = 0; j <= i; j++) {
-            for (int mask = 0; mask < sz; mask++) {
-                fc[i][mask] += fa[j][mask] * fb[i - j][mask];
-            }
+// MInt 版本：乘积累加到 64 位整数，每 16 项取一次模（要求模数小于 2^30）
+template <int P>
+MInt<P> dot_rev(const MInt<P>* x, const MInt<P>* y, int len) {
+    unsigned long long s = 0;
+    for (int i = 0; i < len; i++) {
+        s += (unsigned long long)x[i].x * y[len - 1 - i].x;
+        if ((i & 15) == 15) {
+            s %= MInt<P>::getMod();
         }
     }
+    return MInt<P>(s % MInt<P>::getMod());
+}
 
-    // 逆向SOS DP
-    for (int i = 0; i <= n; i++) {
-        // 逆向：减去子集的贡献
-        for (int bit = 0; bit < n; bit++) {
-            for (int mask = 0; mask < sz; mask++) {
-                if (mask & (1 << bit)) {
-                    fc[i][mask] -= fc[i][mask ^ (1 << bit)];
-                }
+// 需要两份秩变换数组，乘积原地写回第一份（k 从高到低，不会覆盖尚未使用的低次项）
+template <typename T>
+vector<T> subset_convolution(const vector<T>& a, const vector<T>& b,
+                             int threads = 1) {
+    int n = __builtin_ctz(a.size());
+    vector<T> fa = ranked_zeta(a, threads);
+    {
+        vector<T> fb = ranked_zeta(b, threads);
+        auto step = [&](T* p) {
+            const T* q = fb.data() + (p - fa.data());
+            for (int k = n; k >= 0; k--) {
+                p[k] = dot_rev(p, q, k + 1);
             }
-        }
+        };
+        ranked_pointwise(fa, n, step, threads);
     }
+    return ranked_moebius(fa, n, threads);
+}
 
-    vector<T> c(sz);
-    for (int mask = 0; mask < sz; mask++) {
-        c[mask] = fc[__builtin_popcount(mask)][mask];
+// 集合幂级数 exp，要求 a[0] = 0：b[S] 为把 S 划分成若干非空块、各块 a 值乘积之和
+// 在秩变换后对每个 mask 做多项式 exp：e' = p' e，即 k e_k = sum j p_j e_{k-j}
+// T 需支持除法（如 MInt），只用一份秩变换数组
+template <typename T>
+vector<T> subset_exp(const vector<T>& a, int threads = 1) {
+    int n = __builtin_ctz(a.size());
+    vector<T> inv(n + 1, 1);
+    for (int k = 1; k <= n; k++) {
+        inv[k] = T(1) / T(k);
     }
+    vector<T> f = ranked_zeta(a, threads);
+    auto step = [&](T* p) {
+        // p[k] 读完后即可被 e_k 覆盖：e_k 只依赖 p[1..k] 与 e[0..k-1]，
+        // 于是先把 k * p_k 存到临时数组
+        T kp[32];
+        for (int k = 1; k <= n; k++) {
+            kp[k] = p[k] * T(k);
+        }
+        p[0] = 1;
+        for (int k = 1; k <= n; k++) {
+            p[k] = dot_rev(kp + 1, p, k) * inv[k];
+        }
+    };
+    ranked_pointwise(f, n, step, threads);
+    return ranked_moebius(f, n, threads);
+}
 
-    return c;
+// 集合幂级数 log，要求 a[0] = 1，为 subset_exp 的逆
+// 对每个 mask：k l_k = k p_k - sum_{j=1}^{k-1} j l_j p_{k-j}
+template <typename T>
+vector<T> subset_log(const vector<T>& a, int threads = 1) {
+    int n = __builtin_ctz(a.size());
+    vector<T> inv(n + 1, 1);
+    for (int k = 1; k <= n; k++) {
+        inv[k] = T(1) / T(k);
+    }
+    vector<T> f = ranked_zeta(a, threads);
+    auto step = [&](T* p) {
+        // 原地：p[k] 在第 k 步被 l_k 覆盖，之后只会以 l_j (j < k) 的身份被读取，
+        // 而 p_{k-j} 需要的是原值，所以先复制一份原值
+        T q[32], jl[32];
+        copy(p, p + n + 1, q);
+        for (int k = 1; k <= n; k++) {
+            T s = q[k] * T(k) - dot_rev(jl + 1, q + 1, k - 1);
+            p[k] = s * inv[k];
+            jl[k] = s;
+        }
+        p[0] = 0;
+    };
+    ranked_pointwise(f, n, step, threads);
+    return ranked_moebius(f, n, threads);
+}
+
+// 基准测试：逐位扫描整个数组的朴素写法与 sos_transform（加法、模 998244353）
+void benchmark(int n = 27) {
+    constexpr unsigned MOD = 998244353;
+    mt19937 rng(20251017);
+    vector<unsigned> a(1 << n);
+    for (auto& x : a) {
+        x = rng() % MOD;
+    }
+    auto timeit = [&](auto&& fn) {
+        auto st = chrono::steady_clock::now();
+        fn();
+        return chrono::duration<double>(chrono::steady_clock::now() - st)
+            .count();
+    };
+
+    vector<unsigned> b = a, c = a, d = a;
+    double t1 = timeit([&] {
+        for (int i = 0; i < n; i++) {
+            for (int mask = 0; mask < (1 << n); mask++) {
+                if (mask & (1 << i)) {
+                    b[mask] += b[mask ^ (1 << i)];
+                }
+            }
+        }
+    });
+    double t2 = timeit([&] { sos_transform(c); });
+    assert(b == c);
+    double t3 = timeit([&] { sos_transform<ModOp<MOD>>(d); });
+    double t4 = timeit([&] { sos_transform<ModOp<MOD>>(d, false, true); });
+    assert(d == a);
+    cout << "n = " << n << ": naive " << t1 << "s, zeta(+) " << t2
+         << "s, zeta(mod) " << t3 << "s, mobius(mod) " << t4 << "s\n";
 }
 
 // 应用3：最大独立集问题（状压DP优化）
@@ -2,6 +2,8 @@
  * 线段树 (Segment Tree)
  * 功能：区间修改，区间查询
  * 使用方法：定义Info和Tag结构体，实现对应的操作
+ * LazySegmentTree 为递归写法；IterLazySegmentTree 为非递归自底向上写法，
+ * 接口相同，另有 maxRight/minLeft 线段树上二分，常数与内存都更小
  */
 #include <bits/stdc++.h>
 using namespace std;
@@ -125,3 +127,190 @@ struct LazySegmentTree {
         return rangeApply(1, 0, n, l, r, v);
     }
 };
+
+// 非递归懒标记线段树：叶子补齐到 2 的幂，叶子 [sz, 2sz)，标记只存在内部节点
+template <class Info, class Tag>
+struct IterLazySegmentTree {
+    int n, sz, lg;
+    vector<Info> info;
+    vector<Tag> tag;
+
+    IterLazySegmentTree() : n(0) {}
+    IterLazySegmentTree(int n_, Info v_ = Info()) { init(n_, v_); }
+
+    template <class T>
+    IterLazySegmentTree(vector<T> init_) {
+        init(init_);
+    }
+
+    void init(int n_, Info v_ = Info()) { init(vector(n_, v_)); }
+
+    template <class T>
+    void init(vector<T> init_) {
+        n = init_.size();
+        lg = 0;
+        while ((1 << lg) < n) {
+            lg++;
+        }
+        sz = 1 << lg;
+        info.assign(2 * sz, Info());
+        tag.assign(sz, Tag());
+        for (int i = 0; i < n; i++) {
+            info[sz + i] = init_[i];
+        }
+        for (int i = sz - 1; i >= 1; i--) {
+            pull(i);
+        }
+    }
+
+    void pull(int p) { info[p] = info[2 * p] + info[2 * p + 1]; }
+
+    void apply(int p, const Tag& v) {
+        info[p].apply(v);
+        if (p < sz) {
+            tag[p].apply(v);
+        }
+    }
+
+    void push(int p) {
+        apply(2 * p, tag[p]);
+        apply(2 * p + 1, tag[p]);
+        tag[p] = Tag();
+    }
+
+    void modify(int p, const Info& v) {
+        p += sz;
+        for (int i = lg; i >= 1; i--) {
+            push(p >> i);
+        }
+        info[p] = v;
+        for (int i = 1; i <= lg; i++) {
+            pull(p >> i);
+        }
+    }
+
+    // 只下推 l、r 两条边界路径；完全落在区间内的子树不需要下推
+    Info rangeQuery(int l, int r) {
+        if (l >= r) {
+            return Info();
+        }
+        l += sz;
+        r += sz;
+        for (int i = lg; i >= 1; i--) {
+            if (((l >> i) << i) != l) {
+                push(l >> i);
+            }
+            if (((r >> i) << i) != r) {
+                push((r - 1) >> i);
+            }
+        }
+        Info sl, sr;
+        while (l < r) {
+            if (l & 1) {
+                sl = sl + info[l++];
+            }
+            if (r & 1) {
+                sr = info[--r] + sr;
+            }
+            l >>= 1;
+            r >>= 1;
+        }
+        return sl + sr;
+    }
+
+    void rangeApply(int l, int r, const Tag& v) {
+        if (l >= r) {
+            return;
+        }
+        l += sz;
+        r += sz;
+        for (int i = lg; i >= 1; i--) {
+            if (((l >> i) << i) != l) {
+                push(l >> i);
+            }
+            if (((r >> i) << i) != r) {
+                push((r - 1) >> i);
+            }
+        }
+        for (int a = l, b = r; a < b; a >>= 1, b >>= 1) {
+            if (a & 1) {
+                apply(a++, v);
+            }
+            if (b & 1) {
+                apply(--b, v);
+            }
+        }
+        for (int i = 1; i <= lg; i++) {
+            if (((l >> i) << i) != l) {
+                pull(l >> i);
+            }
+            if (((r >> i) << i) != r) {
+                pull((r - 1) >> i);
+            }
+        }
+    }
+
+    // 返回最大的 r 使得 pred(rangeQuery(l, r)) 为真，要求 pred(Info()) 为真且单调
+    template <class F>
+    int maxRight(int l, F pred) {
+        if (l == n) {
+            return n;
+        }
+        l += sz;
+        for (int i = lg; i >= 1; i--) {
+            push(l >> i);
+        }
+        Info s;
+        do {
+            while (l % 2 == 0) {
+                l >>= 1;
+            }
+            if (!pred(s + info[l])) {
+                while (l < sz) {
+                    push(l);
+                    l = 2 * l;
+                    if (pred(s + info[l])) {
+                        s = s + info[l];
+                        l++;
+                    }
+                }
+                return min(l - sz, n);
+            }
+            s = s + info[l];
+            l++;
+        } while ((l & -l) != l);
+        return n;
+    }
+
+    // 返回最小的 l 使得 pred(rangeQuery(l, r)) 为真，要求 pred(Info()) 为真且单调
+    template <class F>
+    int minLeft(int r, F pred) {
+        if (r == 0) {
+            return 0;
+        }
+        r += sz;
+        for (int i = lg; i >= 1; i--) {
+            push((r - 1) >> i);
+        }
+        Info s;
+        do {
+            r--;
+            while (r > 1 && (r % 2)) {
+                r >>= 1;
+            }
+            if (!pred(info[r] + s)) {
+                while (r < sz) {
+                    push(r);
+                    r = 2 * r + 1;
+                    if (pred(info[r] + s)) {
+                        s = info[r] + s;
+                        r--;
+                    }
+                }
+                return r + 1 - sz;
+            }
+            s = info[r] + s;
+        } while ((r & -r) != r);
+        return 0;
+    }
+};
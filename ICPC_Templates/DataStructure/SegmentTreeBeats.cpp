@@ -0,0 +1,350 @@
+/**
+ * 吉司机线段树 (Segment Tree Beats)
+ * 功能：区间取 min、区间取 max、区间加，区间求和/最值；另附历史最大值版本
+ * 复杂度：均摊 O(log^2 n)（只有取 min/取 max 时为 O(log n)）
+ * 使用方法：与 SegmentTree.cpp 类似，但懒标记放在 Info 内部，Info 需要实现
+ *   breakCond(t)：整棵子树都不会被 t 改变，直接返回
+ *   tagCond(t)  ：可以直接在这个节点上打标记（叶子必须恒为真）
+ *   apply(t)、push(ls, rs)、operator+
+ */
+#include <bits/stdc++.h>
+using namespace std;
+using ll = long long;
+
+template <class Info, class Tag>
+struct SegmentTreeBeats {
+    int n;
+    vector<Info> info;
+
+    SegmentTreeBeats() : n(0) {}
+
+    template <class T>
+    SegmentTreeBeats(vector<T> init_) {
+        init(init_);
+    }
+
+    template <class T>
+    void init(vector<T> init_) {
+        n = init_.size();
+        info.assign(4 << __lg(max(n, 1)), Info());
+        build(1, 0, n, init_);
+    }
+
+    template <class T>
+    void build(int p, int l, int r, const vector<T>& a) {
+        if (r - l == 1) {
+            info[p] = Info(a[l]);
+            return;
+        }
+        int m = (l + r) / 2;
+        build(2 * p, l, m, a);
+        build(2 * p + 1, m, r, a);
+        pull(p);
+    }
+
+    void pull(int p) { info[p] = info[2 * p] + info[2 * p + 1]; }
+
+    void push(int p) { info[p].push(info[2 * p], info[2 * p + 1]); }
+
+    Info rangeQuery(int p, int l, int r, int x, int y) {
+        if (l >= y || r <= x) {
+            return Info();
+        }
+        if (l >= x && r <= y) {
+            return info[p];
+        }
+        int m = (l + r) / 2;
+        push(p);
+        return rangeQuery(2 * p, l, m, x, y) +
+               rangeQuery(2 * p + 1, m, r, x, y);
+    }
+
+    Info rangeQuery(int l, int r) { return rangeQuery(1, 0, n, l, r); }
+
+    void rangeApply(int p, int l, int r, int x, int y, const Tag& v) {
+        if (l >= y || r <= x || info[p].breakCond(v)) {
+            return;
+        }
+        if (l >= x && r <= y && info[p].tagCond(v)) {
+            info[p].apply(v);
+            return;
+        }
+        int m = (l + r) / 2;
+        push(p);
+        rangeApply(2 * p, l, m, x, y, v);
+        rangeApply(2 * p + 1, m, r, x, y, v);
+        pull(p);
+    }
+
+    void rangeApply(int l, int r, const Tag& v) {
+        rangeApply(1, 0, n, l, r, v);
+    }
+};
+
+const ll INF = 4e18;
+
+// 版本1：区间取 min / 取 max / 加，区间和、最大值、最小值
+struct Tag {
+    int op;  // 0: 加 v，1: 对 v 取 min，2: 对 v 取 max
+    ll v;
+};
+
+struct Info {
+    ll sum = 0;
+    ll mx = -INF, se = -INF, mn = INF, sm = INF;  // 最大、严格次大、最小、严格次小
+    int cmx = 0, cmn = 0, len = 0;
+    ll tmx = 0, tmn = 0, tot = 0;  // 最大值、最小值、其余元素的加法标记
+
+    Info() {}
+    Info(ll x) : sum(x), mx(x), mn(x), cmx(1), cmn(1), len(1) {}
+
+    bool breakCond(const Tag& t) const {
+        if (t.op == 1) return t.v >= mx;
+        if (t.op == 2) return t.v <= mn;
+        return false;
+    }
+
+    bool tagCond(const Tag& t) const {
+        if (t.op == 1) return t.v > se;
+        if (t.op == 2) return t.v < sm;
+        return true;
+    }
+
+    // 最大值加 a，最小值加 b，其余加 c
+    void update(ll a, ll b, ll c) {
+        if (mx == mn) {
+            if (a == c) {
+                a = b;
+            } else {
+                b = a;
+            }
+            sum += a * cmx;
+        } else {
+            sum += a * cmx + b * cmn + c * (len - cmx - cmn);
+        }
+        if (sm == mx) {
+            sm += a;
+        } else if (sm != INF) {
+            sm += c;
+        }
+        if (se == mn) {
+            se += b;
+        } else if (se != -INF) {
+            se += c;
+        }
+        mx += a;
+        mn += b;
+        tmx += a;
+        tmn += b;
+        tot += c;
+    }
+
+    void apply(const Tag& t) {
+        if (t.op == 0) {
+            update(t.v, t.v, t.v);
+        } else if (t.op == 1) {
+            update(t.v - mx, 0, 0);
+        } else {
+            update(0, t.v - mn, 0);
+        }
+    }
+
+    // 儿子的最大值等于两儿子最大值中的较大者，才接收最大值标记
+    void push(Info& l, Info& r) {
+        ll M = max(l.mx, r.mx), N = min(l.mn, r.mn);
+        for (Info* c : {&l, &r}) {
+            c->update(c->mx == M ? tmx : tot, c->mn == N ? tmn : tot, tot);
+        }
+        tmx = tmn = tot = 0;
+    }
+};
+
+Info operator+(const Info& a, const Info& b) {
+    Info c;
+    c.sum = a.sum + b.sum;
+    c.len = a.len + b.len;
+    if (a.mx == b.mx) {
+        c.mx = a.mx;
+        c.cmx = a.cmx + b.cmx;
+        c.se = max(a.se, b.se);
+    } else if (a.mx > b.mx) {
+        c.mx = a.mx;
+        c.cmx = a.cmx;
+        c.se = max(a.se, b.mx);
+    } else {
+        c.mx = b.mx;
+        c.cmx = b.cmx;
+        c.se = max(a.mx, b.se);
+    }
+    if (a.mn == b.mn) {
+        c.mn = a.mn;
+        c.cmn = a.cmn + b.cmn;
+        c.sm = min(a.sm, b.sm);
+    } else if (a.mn < b.mn) {
+        c.mn = a.mn;
+        c.cmn = a.cmn;
+        c.sm = min(a.sm, b.mn);
+    } else {
+        c.mn = b.mn;
+        c.cmn = b.cmn;
+        c.sm = min(a.mn, b.sm);
+    }
+    return c;
+}
+
+// 版本2：区间加、区间取 min，区间和、最大值、历史最大值
+struct HistTag {
+    int op;  // 0: 加 v，1: 对 v 取 min
+    ll v;
+};
+
+struct HistInfo {
+    ll sum = 0;
+    ll mx = -INF, se = -INF, hmx = -INF;  // 最大、严格次大、历史最大
+    int cmx = 0, len = 0;
+    // 最大值/其余元素的加法标记，以及标记期间的最大前缀和
+    ll a1 = 0, h1 = 0, a2 = 0, h2 = 0;
+
+    HistInfo() {}
+    HistInfo(ll x) : sum(x), mx(x), hmx(x), cmx(1), len(1) {}
+
+    bool breakCond(const HistTag& t) const { return t.op == 1 && t.v >= mx; }
+
+    bool tagCond(const HistTag& t) const { return t.op == 0 || t.v > se; }
+
+    void update(ll a, ll ha, ll b, ll hb) {
+        sum += a * cmx + b * (len - cmx);
+        hmx = max(hmx, mx + ha);
+        mx += a;
+        if (se != -INF) {
+            se += b;
+        }
+        h1 = max(h1, a1 + ha);
+        a1 += a;
+        h2 = max(h2, a2 + hb);
+        a2 += b;
+    }
+
+    void apply(const HistTag& t) {
+        if (t.op == 0) {
+            update(t.v, t.v, t.v, t.v);
+        } else {
+            update(t.v - mx, t.v - mx, 0, 0);
+        }
+    }
+
+    void push(HistInfo& l, HistInfo& r) {
+        ll M = max(l.mx, r.mx);
+        for (HistInfo* c : {&l, &r}) {
+            if (c->mx == M) {
+                c->update(a1, h1, a2, h2);
+            } else {
+                c->update(a2, h2, a2, h2);
+            }
+        }
+        a1 = h1 = a2 = h2 = 0;
+    }
+};
+
+HistInfo operator+(const HistInfo& a, const HistInfo& b) {
+    HistInfo c;
+    c.sum = a.sum + b.sum;
+    c.len = a.len + b.len;
+    c.hmx = max(a.hmx, b.hmx);
+    if (a.mx == b.mx) {
+        c.mx = a.mx;
+        c.cmx = a.cmx + b.cmx;
+        c.se = max(a.se, b.se);
+    } else if (a.mx > b.mx) {
+        c.mx = a.mx;
+        c.cmx = a.cmx;
+        c.se = max(a.se, b.mx);
+    } else {
+        c.mx = b.mx;
+        c.cmx = b.cmx;
+        c.se = max(a.mx, b.se);
+    }
+    return c;
+}
+
+// 使用示例
+void example() {
+    vector<ll> a = {5, 1, 4, 2, 3};
+    SegmentTreeBeats<Info, Tag> seg(a);
+
+    seg.rangeApply(0, 5, {1, 3});  // 对 3 取 min：3 1 3 2 3
+    seg.rangeApply(0, 5, {2, 2});  // 对 2 取 max：3 2 3 2 3
+    seg.rangeApply(1, 3, {0, 4});  // 加 4：      3 6 7 2 3
+    cout << seg.rangeQuery(0, 5).sum << "\n";  // 21
+
+    SegmentTreeBeats<HistInfo, HistTag> hist(a);
+    hist.rangeApply(0, 5, {0, 10});  // 15 11 14 12 13
+    hist.rangeApply(0, 5, {1, 0});   // 0 0 0 0 0
+    cout << hist.rangeQuery(0, 5).hmx << "\n";  // 15
+}
+
+// 基准测试：与逐元素暴力修改对比
+void benchmark(int n = 200000, int q = 200000) {
+    mt19937 rng(20251017);
+    vector<ll> a(n);
+    for (auto& x : a) {
+        x = rng() % 1000000000;
+    }
+    vector<tuple<int, int, int, ll>> ops(q);
+    for (auto& [op, l, r, v] : ops) {
+        op = rng() % 4;
+        l = rng() % n;
+        r = rng() % n;
+        if (l > r) {
+            swap(l, r);
+        }
+        r++;
+        v = op == 0 ? (ll)(rng() % 2000) - 1000 : rng() % 1000000000;
+    }
+
+    auto timeit = [&](auto&& fn) {
+        auto st = chrono::steady_clock::now();
+        ll res = fn();
+        double t =
+            chrono::duration<double>(chrono::steady_clock::now() - st).count();
+        return pair(t, res);
+    };
+
+    auto [t1, r1] = timeit([&] {
+        vector<ll> b = a;
+        ll chk = 0;
+        for (auto [op, l, r, v] : ops) {
+            if (op == 3) {
+                chk += accumulate(b.begin() + l, b.begin() + r, 0LL);
+            } else {
+                for (int i = l; i < r; i++) {
+                    b[i] = op == 0 ? b[i] + v : op == 1 ? min(b[i], v)
+                                                        : max(b[i], v);
+                }
+            }
+        }
+        return chk;
+    });
+
+    auto [t2, r2] = timeit([&] {
+        SegmentTreeBeats<Info, Tag> seg(a);
+        ll chk = 0;
+        for (auto [op, l, r, v] : ops) {
+            if (op == 3) {
+                chk += seg.rangeQuery(l, r).sum;
+            } else {
+                seg.rangeApply(l, r, {op, v});
+            }
+        }
+        return chk;
+    });
+
+    assert(r1 == r2);
+    cout << "naive: " << t1 << "s, beats: " << t2 << "s\n";
+}
+
+int main() {
+    example();
+    benchmark();
+    return 0;
+}
@@ -0,0 +1,459 @@
+/**
+ * 小波矩阵 (Wavelet Matrix)
+ * 功能：静态序列上的区间第 k 小、值的出现次数与第 k 次出现位置、
+ *       区间值域 [a, b) 计数、区间前驱/后继
+ * 复杂度：预处理 O(n log σ)，查询 O(log σ)（select 为 O(log σ log n)）
+ * 空间：每层一个 n 位的 rank/select 位向量，约 1.15 · n · log σ 位，
+ *       远小于可持久化线段树 / 可持久化 Trie 的 O(n log n) 个节点
+ * 值需非负，log σ 取最大值的位数；值域很大时可先离散化
+ */
+#include <bits/stdc++.h>
+using namespace std;
+using ll = long long;
+
+// 位向量：每 64 字节的块存一个前缀计数和 7 个字，rank 只访问一条缓存行
+struct BitVector {
+    struct alignas(64) Block {
+        unsigned long long cnt = 0;  // 块之前 1 的个数
+        unsigned long long w[7] = {};
+    };
+    static constexpr int BITS = 448;
+
+    int n = 0;
+    vector<Block> b;
+
+    BitVector() {}
+    BitVector(int n_) : n(n_), b(n_ / BITS + 1) {}
+
+    void set(int i) { b[i / BITS].w[i % BITS / 64] |= 1ULL << (i % 64); }
+
+    bool get(int i) const {
+        return b[i / BITS].w[i % BITS / 64] >> (i % 64) & 1;
+    }
+
+    void build() {
+        unsigned long long c = 0;
+        for (auto& x : b) {
+            x.cnt = c;
+            for (auto w : x.w) {
+                c += __builtin_popcountll(w);
+            }
+        }
+    }
+
+    // [0, i) 中 1 的个数；7 个字都参与计算，无分支
+    int rank1(int i) const {
+        const Block& x = b[i / BITS];
+        int o = i % BITS, q = o / 64;
+        unsigned long long part = (1ULL << (o % 64)) - 1;
+        int r = x.cnt;
+        for (int j = 0; j < 7; j++) {
+            unsigned long long m = j < q ? ~0ULL : j == q ? part : 0;
+            r += __builtin_popcountll(x.w[j] & m);
+        }
+        return r;
+    }
+
+    int rank0(int i) const { return i - rank1(i); }
+
+    static int selectWord(unsigned long long w, int k) {  // 第 k 个 1，k 从 0 开始
+        while (k--) {
+            w &= w - 1;
+        }
+        return __builtin_ctzll(w);
+    }
+
+    // 第 k 个 1 的位置（k 从 1 开始），不存在返回 -1
+    int select1(int k) const {
+        if (k <= 0 || k > rank1(n)) {
+            return -1;
+        }
+        int lo = 0, hi = b.size() - 1;  // 最后一个 cnt < k 的块
+        while (lo < hi) {
+            int m = (lo + hi + 1) / 2;
+            if ((int)b[m].cnt < k) {
+                lo = m;
+            } else {
+                hi = m - 1;
+            }
+        }
+        k -= b[lo].cnt;
+        for (int j = 0;; j++) {
+            int c = __builtin_popcountll(b[lo].w[j]);
+            if (k <= c) {
+                return lo * BITS + j * 64 + selectWord(b[lo].w[j], k - 1);
+            }
+            k -= c;
+        }
+    }
+
+    // 第 k 个 0 的位置（k 从 1 开始），不存在返回 -1
+    int select0(int k) const {
+        if (k <= 0 || k > rank0(n)) {
+            return -1;
+        }
+        int lo = 0, hi = b.size() - 1;
+        while (lo < hi) {
+            int m = (lo + hi + 1) / 2;
+            if ((int)(1LL * m * BITS - b[m].cnt) < k) {
+                lo = m;
+            } else {
+                hi = m - 1;
+            }
+        }
+        k -= lo * BITS - b[lo].cnt;
+        for (int j = 0;; j++) {
+            int c = 64 - __builtin_popcountll(b[lo].w[j]);
+            if (k <= c) {
+                return lo * BITS + j * 64 + selectWord(~b[lo].w[j], k - 1);
+            }
+            k -= c;
+        }
+    }
+
+    size_t memory() const { return b.capacity() * sizeof(Block); }
+};
+
+// 区间均为左闭右开 [l, r)，k 从 1 开始
+template <class T = int>
+struct WaveletMatrix {
+    int n, LOG;
+    vector<BitVector> bv;  // bv[h]：第 h 位所在层，从高位到低位依次稳定划分
+    vector<int> zeros;     // zeros[h]：该层 0 的个数
+
+    WaveletMatrix(vector<T> a) : n(a.size()) {
+        T mx = a.empty() ? 0 : *max_element(a.begin(), a.end());
+        LOG = 1;
+        while (LOG < (int)sizeof(T) * 8 && (mx >> LOG) > 0) {
+            LOG++;
+        }
+        bv.resize(LOG);
+        zeros.resize(LOG);
+        vector<T> tmp(n);
+        for (int h = LOG - 1; h >= 0; h--) {
+            bv[h] = BitVector(n);
+            int z = 0;
+            for (int i = 0; i < n; i++) {
+                if (a[i] >> h & 1) {
+                    bv[h].set(i);
+                } else {
+                    z++;
+                }
+            }
+            bv[h].build();
+            zeros[h] = z;
+            int p0 = 0, p1 = z;
+            for (int i = 0; i < n; i++) {
+                tmp[(a[i] >> h & 1) ? p1++ : p0++] = a[i];
+            }
+            swap(a, tmp);
+        }
+    }
+
+    // x 超出值域（负数或不小于 2^LOG）
+    bool outOfRange(T x) const {
+        return x < 0 || (LOG < (int)sizeof(T) * 8 && (x >> LOG) > 0);
+    }
+
+    T access(int i) const {
+        T res = 0;
+        for (int h = LOG - 1; h >= 0; h--) {
+            if (bv[h].get(i)) {
+                res |= T(1) << h;
+                i = zeros[h] + bv[h].rank1(i);
+            } else {
+                i = bv[h].rank0(i);
+            }
+        }
+        return res;
+    }
+
+    T kth_smallest(int l, int r, int k) const {
+        T res = 0;
+        for (int h = LOG - 1; h >= 0; h--) {
+            int l0 = bv[h].rank0(l), r0 = bv[h].rank0(r);
+            int c = r0 - l0;
+            if (k <= c) {
+                l = l0;
+                r = r0;
+            } else {
+                k -= c;
+                res |= T(1) << h;
+                l = zeros[h] + l - l0;
+                r = zeros[h] + r - r0;
+            }
+        }
+        return res;
+    }
+
+    T kth_largest(int l, int r, int k) const {
+        return kth_smallest(l, r, r - l - k + 1);
+    }
+
+    // [l, r) 中小于 x 的个数，即 x 在区间内的排名减一
+    int count_less(int l, int r, T x) const {
+        if (x < 0) {
+            return 0;
+        }
+        if (outOfRange(x)) {
+            return r - l;
+        }
+        int res = 0;
+        for (int h = LOG - 1; h >= 0; h--) {
+            int l0 = bv[h].rank0(l), r0 = bv[h].rank0(r);
+            if (x >> h & 1) {
+                res += r0 - l0;
+                l = zeros[h] + l - l0;
+                r = zeros[h] + r - r0;
+            } else {
+                l = l0;
+                r = r0;
+            }
+        }
+        return res;
+    }
+
+    // [l, r) 中值在 [a, b) 内的个数
+    int range_freq(int l, int r, T a, T b) const {
+        return a < b ? count_less(l, r, b) - count_less(l, r, a) : 0;
+    }
+
+    // 按 x 的各位走到最底层，返回 x 在 [l, r) 对应的最底层区间
+    pair<int, int> descend(int l, int r, T x) const {
+        for (int h = LOG - 1; h >= 0; h--) {
+            if (x >> h & 1) {
+                l = zeros[h] + bv[h].rank1(l);
+                r = zeros[h] + bv[h].rank1(r);
+            } else {
+                l = bv[h].rank0(l);
+                r = bv[h].rank0(r);
+            }
+        }
+        return {l, r};
+    }
+
+    // [l, r) 中 x 的出现次数
+    int rank(T x, int l, int r) const {
+        if (outOfRange(x)) {
+            return 0;
+        }
+        auto [lo, hi] = descend(l, r, x);
+        return hi - lo;
+    }
+
+    // [0, r) 中 x 的出现次数
+    int rank(T x, int r) const { return rank(x, 0, r); }
+
+    // x 第 k 次出现的位置，不存在返回 -1
+    int select(T x, int k) const {
+        if (outOfRange(x) || k <= 0) {
+            return -1;
+        }
+        auto [lo, hi] = descend(0, n, x);
+        if (k > hi - lo) {
+            return -1;
+        }
+        int p = lo + k - 1;
+        for (int h = 0; h < LOG; h++) {
+            if (x >> h & 1) {
+                p = bv[h].select1(p - zeros[h] + 1);
+            } else {
+                p = bv[h].select0(p + 1);
+            }
+        }
+        return p;
+    }
+
+    // [l, r) 中小于 x 的最大值
+    optional<T> prev_value(int l, int r, T x) const {
+        int c = count_less(l, r, x);
+        if (c == 0) {
+            return nullopt;
+        }
+        return kth_smallest(l, r, c);
+    }
+
+    // [l, r) 中不小于 x 的最小值
+    optional<T> next_value(int l, int r, T x) const {
+        int c = count_less(l, r, x);
+        if (c == r - l) {
+            return nullopt;
+        }
+        return kth_smallest(l, r, c + 1);
+    }
+
+    size_t memory() const {
+        size_t s = zeros.capacity() * sizeof(int);
+        for (auto& v : bv) {
+            s += v.memory();
+        }
+        return s;
+    }
+};
+
+void example() {
+    vector<int> a = {5, 1, 4, 1, 3, 9, 2, 6};
+    WaveletMatrix<int> wm(a);
+    cout << wm.kth_smallest(1, 6, 2) << "\n";     // {1,4,1,3,9} 第 2 小：1
+    cout << wm.range_freq(0, 8, 2, 6) << "\n";    // 值在 [2, 6) 的：5,4,3,2 共 4 个
+    cout << wm.rank(1, 0, 8) << "\n";             // 2
+    cout << wm.select(1, 2) << "\n";              // 第 2 个 1 在下标 3
+    cout << *wm.prev_value(0, 8, 5) << "\n";      // 小于 5 的最大值：4
+    cout << *wm.next_value(0, 8, 7) << "\n";      // 不小于 7 的最小值：9
+}
+
+// 基准测试：n 个 [0, n) 内的随机数，q 次区间第 k 小与区间值域计数，
+// 与节点池版可持久化线段树（同 PersistentSegTree.cpp）对比时间与内存
+void benchmark(int n = 10000000, int q = 1000000) {
+    struct PersistentSegTree {
+        struct Node {
+            int l = 0, r = 0;
+            int cnt = 0;
+        };
+
+        int n;
+        vector<Node> pool;
+        vector<int> roots;
+
+        PersistentSegTree(int n_, size_t reserve) : n(n_) {
+            pool.reserve(reserve + 1);
+            pool.push_back(Node());
+            roots.push_back(0);
+        }
+
+        void add(int p) {
+            int old = roots.back();
+            int root = pool.size(), cur = root;
+            pool.push_back(pool[old]);
+            pool[cur].cnt++;
+            int l = 0, r = n;
+            while (r - l > 1) {
+                int m = (l + r) / 2;
+                bool right = p >= m;
+                old = right ? pool[old].r : pool[old].l;
+                int c = pool.size();
+                pool.push_back(pool[old]);
+                pool[c].cnt++;
+                (right ? pool[cur].r : pool[cur].l) = c;
+                cur = c;
+                (right ? l : r) = m;
+            }
+            roots.push_back(root);
+        }
+
+        int query(int vl, int vr, int k) const {
+            int x = roots[vl], y = roots[vr];
+            int l = 0, r = n;
+            while (r - l > 1) {
+                int m = (l + r) / 2;
+                int cnt = pool[pool[y].l].cnt - pool[pool[x].l].cnt;
+                if (k <= cnt) {
+                    x = pool[x].l;
+                    y = pool[y].l;
+                    r = m;
+                } else {
+                    k -= cnt;
+                    x = pool[x].r;
+                    y = pool[y].r;
+                    l = m;
+                }
+            }
+            return l;
+        }
+
+        // 版本 ver 中值小于 v 的个数
+        int less(int ver, int v) const {
+            int x = roots[ver], l = 0, r = n, res = 0;
+            while (x && r - l > 1) {
+                int m = (l + r) / 2;
+                if (v <= m) {
+                    x = pool[x].l;
+                    r = m;
+                } else {
+                    res += pool[pool[x].l].cnt;
+                    x = pool[x].r;
+                    l = m;
+                }
+            }
+            return res + (x && v > l ? pool[x].cnt : 0);
+        }
+    };
+
+    mt19937 rng(20251017);
+    vector<int> a(n);
+    for (auto& x : a) {
+        x = rng() % n;
+    }
+    vector<array<int, 5>> qs(q);
+    for (auto& [l, r, k, x, y] : qs) {
+        l = rng() % n;
+        r = rng() % n;
+        if (l > r) {
+            swap(l, r);
+        }
+        r++;
+        k = rng() % (r - l) + 1;
+        x = rng() % n;
+        y = rng() % n;
+        if (x > y) {
+            swap(x, y);
+        }
+    }
+
+    auto timeit = [&](auto&& fn) {
+        auto st = chrono::steady_clock::now();
+        fn();
+        return chrono::duration<double>(chrono::steady_clock::now() - st)
+            .count();
+    };
+
+    long long c1 = 0, c2 = 0, f1 = 0, f2 = 0;
+    size_t m1 = 0, m2 = 0;
+    double b1, q1, g1, b2, q2, g2;
+    {
+        optional<WaveletMatrix<int>> wm;
+        b1 = timeit([&] { wm.emplace(a); });
+        m1 = wm->memory();
+        q1 = timeit([&] {
+            for (auto [l, r, k, x, y] : qs) {
+                c1 += wm->kth_smallest(l, r, k);
+            }
+        });
+        g1 = timeit([&] {
+            for (auto [l, r, k, x, y] : qs) {
+                f1 += wm->range_freq(l, r, x, y);
+            }
+        });
+    }
+    {
+        PersistentSegTree seg(n, 1LL * n * (__lg(n) + 2));
+        b2 = timeit([&] {
+            for (int i = 0; i < n; i++) {
+                seg.add(a[i]);
+            }
+        });
+        m2 = seg.pool.capacity() * sizeof(PersistentSegTree::Node);
+        q2 = timeit([&] {
+            for (auto [l, r, k, x, y] : qs) {
+                c2 += seg.query(l, r, k);
+            }
+        });
+        g2 = timeit([&] {
+            for (auto [l, r, k, x, y] : qs) {
+                f2 += seg.less(r, y) - seg.less(l, y) - seg.less(r, x) +
+                      seg.less(l, x);
+            }
+        });
+    }
+
+    assert(c1 == c2 && f1 == f2);
+    cout << "wavelet : " << m1 / 1048576 << "MB, build " << b1 << "s, kth "
+         << q1 << "s, freq " << g1 << "s\n";
+    cout << "persist : " << m2 / 1048576 << "MB, build " << b2 << "s, kth "
+         << q2 << "s, freq " << g2 << "s\n";
+}
+
+int main() {
+    example();
+    return 0;
+}
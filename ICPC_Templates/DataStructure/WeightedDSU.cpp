@@ -6,55 +6,173 @@
 #include <bits/stdc++.h>
 using namespace std;
 
-// 版本1：加法关系（偏移量）
+// 版本1：通用带权并查集
+// 权值取自一个群 G：w[x] 表示关系 val[x] = w[x](val[f[x]])
+// G 需提供：默认构造为单位元，a * b 表示复合 a∘b（先作用 b 再作用 a），
+// inv() 求逆，operator== 判等；群可以不交换（如仿射变换）
+// 按大小合并保证树高不超过 log2(n)，find 用定长栈做两趟迭代路径压缩，
+// 不会因长链递归爆栈
+template <class G>
 struct WeightedDSU {
-    vector<int> f;
-    vector<long long> w;  // w[x] 表示 x 到 f[x] 的权值
+    vector<int> f, siz;
+    vector<G> w;
+
+    WeightedDSU() {}
+    WeightedDSU(int n) { init(n); }
 
-    WeightedDSU(int n) {
+    void init(int n) {
         f.resize(n);
         iota(f.begin(), f.end(), 0);
-        w.assign(n, 0);
+        siz.assign(n, 1);
+        w.assign(n, G());
     }
 
-    // 返回 {根节点, x到根的权值}
-    pair<int, long long> find(int x) {
-        if (x == f[x]) {
-            return {x, 0};
+    // 返回 {根节点, x 到根的关系}
+    pair<int, G> find(int x) {
+        // x 为根或父亲即根时直接返回，不产生写操作（根的 w 恒为单位元）
+        int p = f[x];
+        if (p == f[p]) {
+            return {p, w[x]};
+        }
+        int stk[32], top = 0;
+        int u = x;
+        while (u != f[u]) {
+            stk[top++] = u;
+            u = f[u];
+        }
+        int root = u;
+        // 自顶向下：离根最近的点的 w 已是到根的关系
+        G acc;
+        while (top > 0) {
+            u = stk[--top];
+            acc = w[u] * acc;
+            w[u] = acc;
+            f[u] = root;
         }
-        auto [root, weight] = find(f[x]);
-        f[x] = root;
-        w[x] += weight;
-        return {root, w[x]};
+        return {root, acc};
     }
 
-    // 合并：使得 x 的权值 = y 的权值 + val
-    // 即 w[x] - w[y] = val
-    bool merge(int x, int y, long long val) {
+    // 合并：使得 val[x] = g(val[y])；已在同一集合时返回是否与已有关系一致
+    bool merge(int x, int y, const G& g) {
         auto [rx, wx] = find(x);
         auto [ry, wy] = find(y);
 
         if (rx == ry) {
-            return (wx - wy) == val;
+            return wx == g * wy;
         }
 
-        // 合并：rx -> ry
-        // 需要满足：wx + w[rx] = wy + val
-        f[rx] = ry;
-        w[rx] = wy + val - wx;
+        // val[rx] = (wx^-1 ∘ g ∘ wy)(val[ry])
+        G t = wx.inv() * g * wy;
+        if (siz[rx] < siz[ry]) {
+            f[rx] = ry;
+            w[rx] = t;
+            siz[ry] += siz[rx];
+        } else {
+            f[ry] = rx;
+            w[ry] = t.inv();
+            siz[rx] += siz[ry];
+        }
         return true;
     }
 
-    // 查询 x 和 y 的权值差
-    // 返回 w[x] - w[y]，如果不在同一集合返回 nullopt
-    optional<long long> diff(int x, int y) {
+    // 查询满足 val[x] = g(val[y]) 的 g，如果不在同一集合返回 nullopt
+    optional<G> diff(int x, int y) {
         auto [rx, wx] = find(x);
         auto [ry, wy] = find(y);
 
         if (rx != ry) {
             return nullopt;
         }
-        return wx - wy;
+        return wx * wy.inv();
+    }
+
+    bool same(int x, int y) { return find(x).first == find(y).first; }
+
+    int size(int x) { return siz[find(x).first]; }
+};
+
+// 加法关系（偏移量）：val[x] = val[y] + v
+template <class T = long long>
+struct AddGroup {
+    T v = 0;
+
+    AddGroup() {}
+    AddGroup(T v_) : v(v_) {}
+
+    AddGroup inv() const { return -v; }
+    friend AddGroup operator*(const AddGroup& a, const AddGroup& b) {
+        return a.v + b.v;
+    }
+    friend bool operator==(const AddGroup& a, const AddGroup& b) {
+        return a.v == b.v;
+    }
+};
+
+// 异或关系（奇偶性）：val[x] = val[y] ^ v
+struct XorGroup {
+    unsigned v = 0;
+
+    XorGroup() {}
+    XorGroup(unsigned v_) : v(v_) {}
+
+    XorGroup inv() const { return *this; }
+    friend XorGroup operator*(const XorGroup& a, const XorGroup& b) {
+        return a.v ^ b.v;
+    }
+    friend bool operator==(const XorGroup& a, const XorGroup& b) {
+        return a.v == b.v;
+    }
+};
+
+// 模 K 关系：val[x] = val[y] + v (mod K)，K = 3 即食物链
+template <int K>
+struct ModGroup {
+    int v = 0;
+
+    ModGroup() {}
+    ModGroup(int v_) : v((v_ % K + K) % K) {}
+
+    ModGroup inv() const { return ModGroup(v ? K - v : 0); }
+    friend ModGroup operator*(const ModGroup& a, const ModGroup& b) {
+        int s = a.v + b.v;
+        ModGroup r;
+        r.v = s >= K ? s - K : s;
+        return r;
+    }
+    friend bool operator==(const ModGroup& a, const ModGroup& b) {
+        return a.v == b.v;
+    }
+};
+
+// 仿射关系（P 为质数）：val[x] = a * val[y] + b (mod P)，要求 a != 0
+template <unsigned P>
+struct AffineGroup {
+    unsigned a = 1, b = 0;
+
+    AffineGroup() {}
+    AffineGroup(unsigned a_, unsigned b_) : a(a_ % P), b(b_ % P) {}
+
+    static unsigned power(unsigned x, unsigned long long e) {
+        unsigned long long r = 1, y = x;
+        for (; e; e >>= 1, y = y * y % P) {
+            if (e & 1) {
+                r = r * y % P;
+            }
+        }
+        return r;
+    }
+
+    // v = a u + b  =>  u = a^-1 v - a^-1 b
+    AffineGroup inv() const {
+        unsigned ia = power(a, P - 2);
+        return AffineGroup(ia, (P - 1ULL * ia * b % P) % P);
+    }
+    // (x, y) 先作用 y 再作用 x：a1 (a2 v + b2) + b1
+    friend AffineGroup operator*(const AffineGroup& x, const AffineGroup& y) {
+        return AffineGroup(1ULL * x.a * y.a % P, (1ULL * x.a * y.b + x.b) % P);
+    }
+    friend bool operator==(const AffineGroup& x, const AffineGroup& y) {
+        return x.a == y.a && x.b == y.b;
     }
 };
 
@@ -139,7 +257,7 @@ struct IntervalDSU {
 // 使用示例1：偏移量问题
 void example1() {
     int n = 5;
-    WeightedDSU dsu(n);
+    WeightedDSU<AddGroup<>> dsu(n);
 
     // a[1] - a[0] = 3
     dsu.merge(1, 0, 3);
@@ -150,8 +268,28 @@ void example1() {
     // 查询 a[2] - a[0]
     auto diff = dsu.diff(2, 0);
     if (diff) {
-        cout << "a[2] - a[0] = " << *diff << "\n";  // 输出 5
+        cout << "a[2] - a[0] = " << diff->v << "\n";  // 输出 5
     }
+
+    // 仿射关系：a[1] = 2 a[0] + 1，a[2] = 3 a[1]，则 a[2] = 6 a[0] + 3
+    WeightedDSU<AffineGroup<998244353>> aff(n);
+    aff.merge(1, 0, {2, 1});
+    aff.merge(2, 1, {3, 0});
+    auto g = *aff.diff(2, 0);
+    cout << g.a << " " << g.b << "\n";  // 输出 6 3
+}
+
+// 模 3 带权并查集解食物链（编号从 0 开始）：
+// val[x] - val[y] = 0 表示同类，= 1 表示 x 吃 y
+int food_chain(int n, const vector<array<int, 3>>& qs) {
+    WeightedDSU<ModGroup<3>> dsu(n);
+    int ans = 0;
+    for (auto [type, x, y] : qs) {
+        if (x >= n || y >= n || !dsu.merge(x, y, type - 1)) {
+            ans++;
+        }
+    }
+    return ans;
 }
 
 // 使用示例2：食物链（种类并查集）
@@ -211,6 +349,65 @@ void example3() {
     }
 }
 
+// 对抗性合并顺序：merge(i, i + 1) 依次把已有的链挂到新点下，
+// 不按大小合并时得到长为 n 的链；之后从链底开始查询
+// 旧版为递归 find、无按大小合并，n 较大时会爆栈，只在较小的 n 上对比
+void benchmark(int n = 10000000, int oldN = 100000) {
+    struct Old {
+        vector<int> f;
+        vector<long long> w;
+
+        Old(int n) : f(n), w(n) { iota(f.begin(), f.end(), 0); }
+
+        pair<int, long long> find(int x) {
+            if (x == f[x]) {
+                return {x, 0};
+            }
+            auto [root, weight] = find(f[x]);
+            f[x] = root;
+            w[x] += weight;
+            return {root, w[x]};
+        }
+
+        bool merge(int x, int y, long long val) {
+            auto [rx, wx] = find(x);
+            auto [ry, wy] = find(y);
+            if (rx == ry) {
+                return (wx - wy) == val;
+            }
+            f[rx] = ry;
+            w[rx] = wy + val - wx;
+            return true;
+        }
+    };
+
+    auto run = [&](auto& dsu, int n) {
+        auto st = chrono::steady_clock::now();
+        for (int i = 0; i + 1 < n; i++) {
+            dsu.merge(i, i + 1, 1);
+        }
+        // 再按随机顺序做 n 次查询与一致性检查
+        mt19937 rng(20251017);
+        long long chk = 0;
+        for (int i = 0; i < n; i++) {
+            int x = rng() % n, y = rng() % n;
+            chk += dsu.merge(x, y, y - x);
+        }
+        double t =
+            chrono::duration<double>(chrono::steady_clock::now() - st).count();
+        return pair(t, chk);
+    };
+
+    Old old(oldN);
+    WeightedDSU<AddGroup<>> small(oldN), big(n);
+    auto [t0, c0] = run(old, oldN);
+    auto [t1, c1] = run(small, oldN);
+    auto [t2, c2] = run(big, n);
+    assert(c0 == oldN && c1 == oldN && c2 == n);
+    cout << "n = " << oldN << ": old " << t0 << "s, new " << t1 << "s\n";
+    cout << "n = " << n << ": new " << t2 << "s\n";
+}
+
 int main() {
     ios::sync_with_stdio(false);
     cin.tie(nullptr);
@@ -8,6 +8,8 @@ using ll = long long;
 
 // 1. 斜率优化DP（凸壳优化）
 // 适用于：dp[i] = min(dp[j] + cost(j, i)) 且cost满足四边形不等式
+// slopeDP 要求斜率与询问都单调；顺序任意时用 DataStructure/LiChaoSegmentTree.cpp
+// 中的 LineContainer，单调时同样走均摊 O(1) 的双端队列凸包
 namespace SlopeOptimization {
 struct Line {
     ll k, b;